@@ -17,202 +17,74 @@
 #include <lcdutils.h>
 #include <lcddraw.h>
 #include <p2switches.h>
-#include "shape.h"
-#include <abCircle.h>
+#include <shape.h>
+#include <layerTable.h>
+#include <collide.h>
+#include "gameScene.h"
 #include "buzzer.h"
 
 #define GREEN_LED BIT6
 
+// Simulation steps: 5 watchdog ticks (about 50 a second), and at most 4
+// steps to catch up before rendering
+#define TICKS_PER_STEP 5
+#define MAX_STEPS 4
+
+// Speed in pixels per 20 ticks (the old frame) as a Q8.8 velocity per step
+#define SPEED(pixels) (LAYER_Q8(pixels) * TICKS_PER_STEP / 20)
+
 // Scoring
 int score = 0;
 int score_count = 0;
 
-// Ship custom shape parts
-AbRect shipBody = {abRectGetBounds, abRectCheck, {1,2}};
-AbRect leftWing = {abRectGetBounds, abRectCheck, {1,2}};
-AbRect rightWing = {abRectGetBounds, abRectCheck, {1,2}};
-
-// Playing field
-AbRectOutline fieldOutline = {
-  abRectOutlineGetBounds, abRectOutlineCheck,   
-  {screenWidth/2 - 10, screenHeight/2 - 10}
-};
-
-// Ship custom shape
-Layer shipBodyLayer = {
-    (AbShape *)&shipBody, 
-    // Ship body at center and bottom of the screen
-    {(screenWidth/2), (screenHeight/2)+50},
-    // Last and next position
-    {0,0}, {0,0}, 
-    // Color of ship body set to white
-    COLOR_WHITE, 
-    0
-};
-
-Layer leftWingLayer = {
-    (AbShape *)&leftWing, 
-    // Left wing sligthly to the left and down of ship body 
-    {(screenWidth/2)-3, (screenHeight/2)+53},
-    {0,0}, {0,0}, 
-    COLOR_WHITE, 
-    &shipBodyLayer,
-};
-
-Layer rightWingLayer = {
-    (AbShape *)&rightWing, 
-    // Right wing slightly to the right and down of ship body
-    {(screenWidth/2)+3, (screenHeight/2)+53},
-    {0,0}, {0,0}, 
-    COLOR_WHITE, 
-    &leftWingLayer,
-};
-
-// Asteroids
-Layer asteroid4 = {  
-  (AbShape *)&circle9,
-  // Asteroid 4 to the left and slightly above center of the screen
-  {(screenWidth/2)-20, (screenHeight/2)-5},
-  {0,0}, {0,0},
-  // Color of asteroid set to white
-  COLOR_WHITE,
-  &rightWingLayer,
-};
-  
+// All scene layers, in z order, with their motion.  They are inserted
+// in scene order, so each layer's slot is its scene index (e.g. asteroid1).
+LayerTable layers;
 
-Layer asteroid3 = {
-  (AbShape *)&circle8,
-  // Asteroid 3 to the right and slightly below center of the screen  
-  {(screenWidth/2)+10, (screenHeight/2)+5},
-  {0,0}, {0,0},
-  // Color of asteroid set to gray
-  COLOR_GRAY,
-  &asteroid4,
-};
-
-// Playing field as a layer
-Layer fieldLayer = {
-  (AbShape *) &fieldOutline,
-  // Field layer at center of the screen
-  {screenWidth/2, screenHeight/2},
-  {0,0}, {0,0},				    
-  COLOR_RED,
-  &asteroid3,
-};
-
-Layer asteroid2 = {
-  (AbShape *)&circle4,
-  // Asteroid 2 at center of the screen
-  {screenWidth/2, screenHeight/2},
-  {0,0}, {0,0},				   
-  COLOR_WHITE,
-  &fieldLayer,
-};
-
-Layer asteroid1 = {
-  (AbShape *)&circle14,
-  // Asteroid 1 to the right and slightly below center of the screen
-  {(screenWidth/2)+10, (screenHeight/2)+5},
-  {0,0}, {0,0},
-  COLOR_GRAY,
-  &asteroid2,
-};
-
-/** Moving Layer
- *  Linked list of layer references
- *  Velocity represents one iteration of change (direction & magnitude)
- */
-typedef struct MovLayer_s {
-  Layer *layer;
-  Vec2 velocity;
-  struct MovLayer_s *next;
-} MovLayer;
-
-// initial value of {0,0} will be overwritten 
-MovLayer ml_shipBody = {&shipBodyLayer, {0,0}, 0};
-MovLayer ml_leftWing = {&leftWingLayer, {0,0}, &ml_shipBody};
-MovLayer ml_rightWing = {&rightWingLayer, {0,0}, &ml_leftWing};
-MovLayer ml_asteroid4 = { &asteroid4, {1,1}, &ml_rightWing};
-MovLayer ml_asteroid3 = { &asteroid3, {1,1}, &ml_asteroid4}; 
-MovLayer ml_asteroid2 = { &asteroid2, {1,2}, &ml_asteroid3 }; 
-MovLayer ml_asteroid1 = { &asteroid1, {2,1}, &ml_asteroid2 }; 
-
-void movLayerDraw(MovLayer *movLayers, Layer *layers)
+// Slots of the ship's parts
+static const u_char shipParts[] = {shipBodyLayer, leftWingLayer, rightWingLayer};
+
+// Slot masks of the ship's parts and of the asteroids, for collisions
+#define SHIP_SLOTS (layerTableBit(shipBodyLayer) | layerTableBit(leftWingLayer) | \
+		    layerTableBit(rightWingLayer))
+#define ASTEROID_SLOTS (layerTableBit(asteroid1) | layerTableBit(asteroid2) | \
+			layerTableBit(asteroid3) | layerTableBit(asteroid4))
+
+// Sort and sweep state for collisions between the ship and asteroids
+Collider collider;
+// Set once the ship hits an asteroid
+int gameOver = 0;
+
+// Fixed step simulation and rendering, driven by watchdog ticks
+GameLoop gameLoop;
+
+void movLayerDraw(LayerTable *t)
 {
-  int row, col;
-  MovLayer *movLayer;
-
-  // Disable interrupts (GIE off)
-  and_sr(~8);
-  // For each moving layer
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
-    Layer *l = movLayer->layer;
-    l->posLast = l->pos;
-    l->pos = l->posNext;
-  }
-  // Disable interrupts (GIE on)
-  or_sr(8);
-
-  // For each moving layer
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) {
-    Region bounds;
-    layerGetBounds(movLayer->layer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     // Probe all layers, in order
-         probeLayer = probeLayer->next) {
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } // If probe check 
-	} // For checking all layers at col, row
-	lcd_writeColor(color); 
-      } // For col
-    } // For row
+  u_char slot;
+
+  // For each layer that reached a new pixel since last drawn
+  for (slot = 0; slot < gameScene_count; slot++) {
+    if (t->moved & layerTableBit(slot)) {
+      Region bounds;
+      layerGetBounds(t->layer[slot], &bounds);
+      // Probe all layers, in order, with the renderer specialized to the scene
+      gameScene_drawRegion(&bounds);
+    }
   } // For moving layer being updated
+  layerTableDrawn(t);
 }	  
 
 
 
 //Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}}; /**< Create a fence region */
 
-/** Advances a moving shape within a fence
- *  
- *  \param ml The moving shape to be advanced
- *  \param fence The region which will serve as a boundary for ml
- */
-void mlAdvance(MovLayer *ml, Region *fence)
-{
-  Vec2 newPos;
-  u_char axis;
-  Region shapeBoundary;
-  for (; ml; ml = ml->next) {
-    vec2Add(&newPos, &ml->layer->posNext, &ml->velocity);
-    abShapeGetBounds(ml->layer->abShape, &newPos, &shapeBoundary);
-    for (axis = 0; axis < 2; axis ++) {
-      if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) ||
-	  (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis]) ) {
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	newPos.axes[axis] += (2*velocity);
-      }	// If outside of fence 
-    } // For axis 
-    ml->layer->posNext = newPos;
-  } // For ml 
-}
-
 
 // Allow player to move the ship 
 // Set velocity of ship 
 void setVelocity(int axis, int v) {
-    ml_shipBody.velocity.axes[axis] = v;
-    ml_leftWing.velocity.axes[axis] = v;
-    ml_rightWing.velocity.axes[axis] = v;
+    u_char i;
+    for (i = 0; i < sizeof(shipParts); i++)
+        layers.velocity[shipParts[i]].axes[axis] = SPEED(v);
 }
 
 // Detect user input and move the ship depending on the switch being pressed 
@@ -270,67 +142,84 @@ void moveShip() {
     }
 }
 
+// Called for each pair of touching layers: ends the game if one is
+// part of the ship and the other an asteroid
+void shipContact(u_char slotA, u_char slotB) {
+    u_int pair = layerTableBit(slotA) | layerTableBit(slotB);
+    if ((pair & SHIP_SLOTS) && (pair & ASTEROID_SLOTS))
+        gameOver = 1;
+}
+
 // Check the collisions between the ship and the asteroids
 int checkCollisions() {   
-    int gameOver = 0;
-    // Ship hit box
-    Region shipHitBox;
-    // Bounds of ship hit box
-    layerGetBounds(&rightWingLayer, &shipHitBox);
-    
-    // Asteroid vectors 
-    Vec2 asteroid1_vec_1 = {asteroid1.posNext.axes[0], asteroid1.posNext.axes[1]};
-    Vec2 asteroid2_vec_2 = {asteroid2.posNext.axes[0], asteroid2.posNext.axes[1]};
-    Vec2 asteroid3_vec_3 = {asteroid3.posNext.axes[0], asteroid3.posNext.axes[1]};
-    Vec2 asteroid4_vec_4 = {asteroid4.posNext.axes[0], asteroid4.posNext.axes[1]};
-    Vec2 asteroids[4] = {asteroid1_vec_1, asteroid2_vec_2, asteroid3_vec_3, asteroid4_vec_4};
-    int i; 
-    
-    // Check the collisions between the ship and the asteroids
-    for(i = 0; i < 4; i++) {
-        // Stop the movement of the ship and asteroids of the ship collides with the asteroids
-        if(asteroids[i].axes[0] - 4 < shipHitBox.botRight.axes[0] &&
-            asteroids[i].axes[0] + 4 > shipHitBox.topLeft.axes[0] &&
-            asteroids[i].axes[1] - 4 < shipHitBox.botRight.axes[1] &&
-            asteroids[i].axes[1] + 4 > shipHitBox.topLeft.axes[1]
-            ) {
-            // Stop ship
-            ml_shipBody.velocity.axes[0] = 0;
-            ml_leftWing.velocity.axes[0] = 0;
-            ml_rightWing.velocity.axes[0] = 0;
-            ml_shipBody.velocity.axes[1] = 0;
-            ml_leftWing.velocity.axes[1] = 0;
-            ml_rightWing.velocity.axes[1] = 0;
-    
-            // Stop Asteroids
-            ml_asteroid1.velocity.axes[0] = 0;
-            ml_asteroid2.velocity.axes[0] = 0;
-            ml_asteroid3.velocity.axes[0] = 0;
-            ml_asteroid4.velocity.axes[0] = 0;
-            ml_asteroid1.velocity.axes[1] = 0;
-            ml_asteroid2.velocity.axes[1] = 0;
-            ml_asteroid3.velocity.axes[1] = 0;
-            ml_asteroid4.velocity.axes[1] = 0;
+    if (gameOver)
+        return gameOver;
+    // Pixel-exact test of every ship part against every asteroid
+    collideLayers(&collider, &layers, SHIP_SLOTS | ASTEROID_SLOTS, shipContact);
+    if (gameOver) {
+        // Stop ship and asteroids
+        u_char slot;
+        for (slot = 0; slot < gameScene_count; slot++)
+            layers.velocity[slot].axes[0] = layers.velocity[slot].axes[1] = 0;
         
-            // Display GAME OVER message
-            drawString5x7(screenWidth/2-25,screenHeight/2, "GAME OVER", COLOR_WHITE, COLOR_BLACK);
-            gameOver = 1;
-            // Stop all noises 
-            buzzerSetPeriod(0);
-            return gameOver;
-        }
+        // Stop all noises 
+        buzzerSetPeriod(0);
     }
     return gameOver;
 }
 
 // Background color
 u_int bgColor = COLOR_BLACK;
-// Boolean for whether screen needs to be redrawn
+// Boolean for whether a step is due (wakes the CPU)
 int redrawScreen = 1;
 // Fence around playing field
 Region fieldFence;
 
 
+// One simulation step: read the switches, move everything and check
+// for collisions, on positions committed so collisions see them
+void gameStep()
+{
+    moveShip();
+    layerTableAdvance(&layers, &fieldFence);
+    layerTableCommit(&layers);
+    checkCollisions();
+    // Increment score
+    score_count++;
+    if(score_count == 500 / TICKS_PER_STEP && !gameOver) {
+        score++;
+        score_count = 0;
+    }
+}
+
+// Draw what moved since the last frame, the score and, once the game is
+// over, how the frames went
+void gameRender()
+{
+    static char gameOverShown = 0;
+    char score_str[8];
+    movLayerDraw(&layers);
+    // Display score 
+    itoa(score, score_str, 10);
+    drawString5x7(screenWidth/2 - 25, 3 , "Score:    ", COLOR_WHITE, COLOR_BLACK);
+    drawString5x7(screenWidth/2 + 11, 3 , score_str, COLOR_WHITE, COLOR_BLACK);
+    if (gameOver && !gameOverShown) {
+        gameOverShown = 1;
+        // Display GAME OVER message
+        drawString5x7(screenWidth/2-25,screenHeight/2, "GAME OVER", COLOR_WHITE, COLOR_BLACK);
+        // Frames rendered and skipped, and ticks dropped (the game slowed)
+        formatNum(score_str, gameLoop.frames, 7);
+        drawString5x7(2, screenHeight/2 + 12, "frames", COLOR_WHITE, COLOR_BLACK);
+        drawString5x7(50, screenHeight/2 + 12, score_str, COLOR_WHITE, COLOR_BLACK);
+        formatNum(score_str, gameLoop.skipped, 7);
+        drawString5x7(2, screenHeight/2 + 22, "skipped", COLOR_WHITE, COLOR_BLACK);
+        drawString5x7(50, screenHeight/2 + 22, score_str, COLOR_WHITE, COLOR_BLACK);
+        formatNum(score_str, gameLoop.dropped, 7);
+        drawString5x7(2, screenHeight/2 + 32, "dropped", COLOR_WHITE, COLOR_BLACK);
+        drawString5x7(50, screenHeight/2 + 32, score_str, COLOR_WHITE, COLOR_BLACK);
+    }
+}
+
 /** Initializes everything, enables interrupts and green LED, 
  *  and handles the rendering for the screen
  */
@@ -348,11 +237,34 @@ void main()
 
   shapeInit();
 
-  layerInit(&asteroid1);
-  layerDraw(&asteroid1);
+  // Asteroids start moving; the ship moves once a switch is pressed
+  layerTableInit(&layers);
+  collideInit(&collider);
+  {
+    u_char slot;
+    for (slot = 0; slot < gameScene_count; slot++)
+      layerTableInsert(&layers, &gameScene[slot]);
+  }
+  layerTableSetVelocity(&layers, asteroid1, SPEED(2), SPEED(1));
+  layerTableSetVelocity(&layers, asteroid2, SPEED(1), SPEED(2));
+  layerTableSetVelocity(&layers, asteroid3, SPEED(1), SPEED(1));
+  layerTableSetVelocity(&layers, asteroid4, SPEED(1.5), SPEED(0.75));
+  layerTableSetVelocity(&layers, rightWingLayer, 0, 0);
+  layerTableSetVelocity(&layers, leftWingLayer, 0, 0);
+  layerTableSetVelocity(&layers, shipBodyLayer, 0, 0);
+  // First frame by painter's algorithm: most of the screen is background
+  layerPaint(gameScene);
+
+  // Estimate RAM saved by flash-resident shapes and packed layers
+  char ramSaved[6];
+  itoa(layerRamSavedEstimate(gameScene, sizeof(shipBody) + sizeof(leftWing) +
+                             sizeof(rightWing) + sizeof(fieldOutline)), ramSaved, 10);
+  drawString5x7(2, screenHeight - 8, "Est. saved:", COLOR_WHITE, COLOR_BLACK);
+  drawString5x7(70, screenHeight - 8, ramSaved, COLOR_WHITE, COLOR_BLACK);
   
 
-  layerGetBounds(&fieldLayer, &fieldFence);
+  layerGetBounds(&gameScene[fieldLayer], &fieldFence);
+  gameLoopInit(&gameLoop, gameStep, gameRender, TICKS_PER_STEP, MAX_STEPS);
 
   // Enable preiodic interrupt
   enableWDTInterrupts();
@@ -360,50 +272,24 @@ void main()
   or_sr(0x8);
   
   for(;;) { 
-    // Pause CPU if screen doesn't need updating 
-    while (!redrawScreen) { 
+    // Pause CPU until a step is due
+    while (!gameLoopUpdate(&gameLoop)) { 
         // Green led off witHo CPU
         P1OUT &= ~GREEN_LED;   
         /**< CPU OFF */
         or_sr(0x10);	      
+        // Green led on when CPU on 
+        P1OUT |= GREEN_LED;       
     }
-    // Green led on when CPU on 
-    P1OUT |= GREEN_LED;       
-    redrawScreen = 0;
-    movLayerDraw(&ml_asteroid1, &asteroid1);
-    moveShip();
-    int gameOver = checkCollisions();
-    // Display score 
-    char score_str[4];
-    itoa(score, score_str, 10);
-    drawString5x7(screenWidth/2 - 25, 3 , "Score:    ", COLOR_WHITE, COLOR_BLACK);
-    drawString5x7(screenWidth/2 + 11, 3 , score_str, COLOR_WHITE, COLOR_BLACK);
-   
   }
 }
 
-// Watchdog timer interrupt handler. 20 interrupts/sec 
+// Watchdog timer interrupt handler, about 244 interrupts/sec.  It only
+// counts the tick (and wakes the CPU once a step is due); the game runs
+// in the main loop.
 void wdt_c_handler()
 {
-  static short count = 0;
-  // Green LED on when cpu on
-  P1OUT |= GREEN_LED;
-  count ++;
-  // Increment score
-  score_count++;
-  if(score_count == 500 && checkCollisions() == 0) {
-      score++;
-      score_count = 0;
-  }
-  
-  if (count == 20) {
-    mlAdvance(&ml_asteroid1, &fieldFence);
-    if (p2sw_read())
-      redrawScreen = 1;
-    count = 0;
-  } 
-  // Green LED off when cpu off 
-  P1OUT &= ~GREEN_LED;
+  redrawScreen = gameLoopTick(&gameLoop);
 }
 
 // In collaboration with Cynthia Sustaita (checkCollisions and moveShip).
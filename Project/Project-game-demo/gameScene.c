@@ -0,0 +1,13 @@
+#define SCENE_DEFINE		/* layers and renderer are defined here */
+#include "gameScene.h"
+
+// Ship custom shape parts
+const AbRect shipBody = {abRectGetBounds, abRectCheck, abRectCoverage, {1,2}};
+const AbRect leftWing = {abRectGetBounds, abRectCheck, abRectCoverage, {1,2}};
+const AbRect rightWing = {abRectGetBounds, abRectCheck, abRectCoverage, {1,2}};
+
+// Playing field
+const AbRectOutline fieldOutline = {
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineCoverage,
+  {screenWidth/2 - 10, screenHeight/2 - 10}
+};
@@ -0,0 +1,52 @@
+/** \file gameScene.h
+ *  \brief The Shape Shifter scene: ship, asteroids and playing field.
+ *
+ *  Declared once as an X-macro; sceneGen.h generates the layers
+ *  (gameScene[asteroid1] etc., linked front to back) and a renderer
+ *  specialized to them (gameScene_draw, gameScene_drawRegion).
+ */
+#ifndef gameScene_included
+#define gameScene_included
+
+#include <shape.h>
+#include <abCircle.h>
+
+// Ship custom shape parts
+extern const AbRect shipBody, leftWing, rightWing;
+
+// Playing field
+extern const AbRectOutline fieldOutline;
+
+// Layers, front to back
+#define GAME_SCENE_LAYERS(LAYER)					\
+  /* Asteroid 1 to the right and slightly below center of the screen */ \
+  LAYER(asteroid1, abCircle, circle14, COLOR_GRAY,			\
+	(screenWidth/2)+10, (screenHeight/2)+5)				\
+  /* Asteroid 2 at center of the screen */				\
+  LAYER(asteroid2, abCircle, circle4, COLOR_WHITE,			\
+	screenWidth/2, screenHeight/2)					\
+  /* Playing field at center of the screen */				\
+  LAYER(fieldLayer, abRectOutline, fieldOutline, COLOR_RED,		\
+	screenWidth/2, screenHeight/2)					\
+  /* Asteroid 3 to the right and slightly below center of the screen */ \
+  LAYER(asteroid3, abCircle, circle8, COLOR_GRAY,			\
+	(screenWidth/2)+10, (screenHeight/2)+5)				\
+  /* Asteroid 4 to the left and slightly above center of the screen */ \
+  LAYER(asteroid4, abCircle, circle9, COLOR_WHITE,			\
+	(screenWidth/2)-20, (screenHeight/2)-5)				\
+  /* Right wing slightly to the right and down of ship body */		\
+  LAYER(rightWingLayer, abRect, rightWing, COLOR_WHITE,			\
+	(screenWidth/2)+3, (screenHeight/2)+53)				\
+  /* Left wing sligthly to the left and down of ship body */		\
+  LAYER(leftWingLayer, abRect, leftWing, COLOR_WHITE,			\
+	(screenWidth/2)-3, (screenHeight/2)+53)				\
+  /* Ship body at center and bottom of the screen */			\
+  LAYER(shipBodyLayer, abRect, shipBody, COLOR_WHITE,			\
+	(screenWidth/2), (screenHeight/2)+50)
+
+#define SCENE_CIRCLES		// asteroids are abCircles
+#define SCENE_NAME gameScene
+#define SCENE_LAYERS GAME_SCENE_LAYERS
+#include <sceneGen.h>
+
+#endif // gameScene_included
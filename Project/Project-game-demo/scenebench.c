@@ -0,0 +1,136 @@
+/** \file scenebench.c
+ *  \brief Times the generic and scene-specialized renderers on the game scene.
+ *
+ *  Each renderer draws the full screen, then the bounds of every layer
+ *  (as movLayerDraw does each frame).  The generic renderers are the
+ *  per-pixel probe (abShapeCheck on each layer, front to back, for
+ *  every pixel) and the coverage compositor (layerDraw, 16 pixels per
+ *  probe).  Times are displayed in milliseconds as "test  probe  cov
+ *  spec", followed by the time layerPaint takes to draw the first
+ *  frame.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include "gameScene.h"
+
+u_int bgColor = COLOR_BLACK;
+
+/** Milliseconds since stopwatchStart() (SMCLK is 2 MHz) */
+static u_int
+elapsedMs()
+{
+  return stopwatchRead() / 2000;
+}
+
+const Layer *probes[LAYER_PROBE_MAX];	/* the scene's layers, front to back */
+u_char probeCount;
+
+/** Draws area pixel by pixel, probing each layer's shape in turn */
+static void
+probeRegion(const Region *area)
+{
+  int row, col;
+  lcd_setArea(area->topLeft.axes[0], area->topLeft.axes[1],
+	      area->botRight.axes[0], area->botRight.axes[1]);
+  for (row = area->topLeft.axes[1]; row <= area->botRight.axes[1]; row++) {
+    for (col = area->topLeft.axes[0]; col <= area->botRight.axes[0]; col++) {
+      Vec2 pixelPos = {col, row};
+      u_int color = bgColor;
+      Layer *probeLayer;
+      for (probeLayer = gameScene; probeLayer; probeLayer = probeLayer->next) {
+	Vec2 center;
+	pvec2Unpack(&center, probeLayer->pos);
+	if (abShapeCheck(probeLayer->desc->abShape, &center, &pixelPos)) {
+	  color = probeLayer->desc->color;
+	  break;
+	}
+      }
+      lcd_writeColor(color);
+    }
+  }
+}
+
+/** Draws area with the coverage compositor */
+static void
+coverRegion(const Region *area)
+{
+  layerComposite(probes, probeCount, area);
+}
+
+/** Draws each layer's bounds with renderer */
+static void
+layerBounds(void (*renderer)(const Region *))
+{
+  Layer *l;
+  for (l = gameScene; l; l = l->next) {
+    Region bounds;
+    layerGetBounds(l, &bounds);
+    renderer(&bounds);
+  }
+}
+
+/** Milliseconds renderer takes to draw the bounds of every layer */
+static u_int
+timeBounds(void (*renderer)(const Region *))
+{
+  stopwatchStart();
+  layerBounds(renderer);
+  return elapsedMs();
+}
+
+static void
+report(u_char row, char *name, u_int probeMs, u_int coverMs, u_int specializedMs)
+{
+  char num[6];
+  drawString5x7(2, row, name, COLOR_WHITE, bgColor);
+  formatNum(num, probeMs, 5);
+  drawString5x7(38, row, num, COLOR_RED, bgColor);
+  formatNum(num, coverMs, 5);
+  drawString5x7(68, row, num, COLOR_YELLOW, bgColor);
+  formatNum(num, specializedMs, 5);
+  drawString5x7(98, row, num, COLOR_GREEN, bgColor);
+}
+
+void
+main()
+{
+  static const Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}};
+  u_int probeMs, coverMs, specializedMs, paintMs;
+  Layer *l;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/* GIE on: stopwatch needs its overflow interrupt */
+  layerInit(gameScene);
+  for (l = gameScene; l && probeCount < LAYER_PROBE_MAX; l = l->next)
+    probes[probeCount++] = l;
+
+  stopwatchStart();
+  probeRegion(&screen);
+  probeMs = elapsedMs();
+  stopwatchStart();
+  layerDraw(gameScene);
+  coverMs = elapsedMs();
+  stopwatchStart();
+  gameScene_draw();
+  specializedMs = elapsedMs();
+
+  stopwatchStart();
+  layerPaint(gameScene);
+  paintMs = elapsedMs();
+
+  drawString5x7(2, 20, "ms    probe  cov spec", COLOR_WHITE, bgColor);
+  report(32, "screen", probeMs, coverMs, specializedMs);
+  report(44, "bounds", timeBounds(probeRegion), timeBounds(coverRegion),
+	 timeBounds(gameScene_drawRegion));
+  {				/* painter's algorithm (first frame) */
+    char num[6];
+    drawString5x7(2, 56, "paint", COLOR_WHITE, bgColor);
+    formatNum(num, paintMs, 5);
+    drawString5x7(98, 56, num, COLOR_GREEN, bgColor);
+  }
+
+  or_sr(0x10);			/* CPU off */
+}
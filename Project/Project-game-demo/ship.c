@@ -1,4 +1,4 @@
-#include "shape.h"
+#include <shape.h>
 
 /** Check function required by AbShape
  *  abTriangle returns true if the shape includes the selected pixel
@@ -19,6 +19,17 @@ int abTriangleCheck(const AbTriangle *shape, const Vec2 *centerPos, const Vec2 *
   return within;
 }
   
+/** Coverage function required by AbShape
+ *  abTriangleCoverage computes which of pixels col..col+15 of row are in the triangle
+ */
+u_int abTriangleCoverage(const AbTriangle *shape, const Vec2 *centerPos, int col, int row) {
+  int quarterSize = shape->size/4;
+  row -= centerPos->axes[1];
+  if (row < 0 || row > quarterSize)
+    return 0;
+  return coverageSpan(col, centerPos->axes[0] - row, centerPos->axes[0] + row);
+}
+
 /** Check function required by AbShape
  *  abTriangleGetBounds computes a shape bounding box
  */
@@ -3,19 +3,105 @@
 
 #include "shape.h"
 
+/** Packed chord tables
+ *
+ *  A circle's chord table has radius + 1 entries; entry i is 1/2 chord
+ *  length at distance i from the circle's center.  Entries never
+ *  increase and change by small amounts, so tables are stored in groups
+ *  of CHORD_GROUP entries: each group is its first entry (its base) and
+ *  a byte naming a pattern of drops from the base in chordDrops[].
+ *  makeCircles shares each pattern among all the groups, of every
+ *  circle, that have it.  Entries after the last group are stored raw.
+ *
+ *  A packed table is the number of groups, then (base, pattern) for
+ *  each group, then the remaining entries a byte each.  So a raw table
+ *  (e.g. from computeChordVec) preceded by a 0 is a packed table too.
+ *
+ *  A circle also has a packed table of half widths, indexed by row:
+ *  entry i is the widest column whose chord reaches the row at
+ *  distance i.  Chords aren't symmetric under swapping rows and
+ *  columns, so this isn't the chord table itself.
+ */
+#define CHORD_GROUP 8
+
+extern const u_char chordDrops[][CHORD_GROUP];
+
+/** Entry i of packed chord table chords
+ */
+static inline u_char
+abCircleChord(const u_char *chords, u_char i)
+{
+  u_char groups = chords[0], group = i / CHORD_GROUP;
+  if (group < groups)
+    return chords[1 + 2 * group] - chordDrops[chords[2 + 2 * group]][i % CHORD_GROUP];
+  return chords[1 + groups * 2 + (i - groups * CHORD_GROUP)];
+}
+
 /** AbShape circle
  *  
- *  chords should be a vector of length radius + 1.  
- *  Entry at index i is 1/2 chord length at distance i from the circle's center.  
- *  This vector can be generated using lcdLib's computeChordVec() (lcddraw.h).
+ *  chords and widths should be the packed chord and half width tables
+ *  (see above) for radius.  makeCircles generates all of its circles'
+ *  tables in chordBlob (chordVec.h).
  */ 
 typedef struct AbCircle_s {
   void (*getBounds)(const struct AbCircle_s *circle, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbCircle_s *circle, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbCircle_s *circle, const Vec2 *centerPos, int col, int row);
   const u_char *chords;
+  const u_char *widths;
   const u_char radius;
 } AbCircle;
 
+/** True if pixel is in circle centered at circlePos.
+ *  The body of abCircleCheck, for renderers that inline checks.
+ */
+static inline int
+abCircleContains(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - circlePos->axes[0], row = pixel->axes[1] - circlePos->axes[1];
+  col = (col >= 0) ? col : -col;	/* project to first quadrant */
+  row = (row >= 0) ? row : -row;
+  return col <= circle->radius && abCircleChord(circle->chords, col) >= row;
+}
+
+/** Half width of the circle's row at distance row from its center
+ *  (the widest column whose chord reaches it), or -1 if the row misses.
+ *  One entry of its half width table, as abCircleContains takes one of
+ *  its chord table.
+ */
+static inline int
+abCircleHalfWidth(const AbCircle *circle, int row)
+{
+  row = (row >= 0) ? row : -row;
+  if (row > circle->radius)
+    return -1;
+  return abCircleChord(circle->widths, row);
+}
+
+#include "computeChordVec.h"
+
+/** Runtime circles
+ *
+ *  abCircleNew builds an AbCircle of any radius, and its chord table,
+ *  in a static arena of CIRCLE_ARENA_SIZE bytes shared by all runtime
+ *  circles.  Circles are reference counted: asking again for a radius
+ *  already in the arena returns the same circle, and its space is
+ *  reused once every user has called abCircleRelease.  A circle of
+ *  radius r takes about 2r + 18 bytes.
+ */
+#define CIRCLE_ARENA_SIZE 128	/* bytes; at most 255 */
+
+/** A circle of radius, shared with other users of the same radius.
+ *  \return the circle, or 0 if the arena has no room for it
+ */
+const AbCircle *abCircleNew(u_char radius);
+
+/** Drop one reference to circle (from abCircleNew).
+ *  Circles not from the arena (e.g. circle14), and circles already
+ *  released by all their users, are ignored.
+ */
+void abCircleRelease(const AbCircle *circle);
+
 /** Required by AbShape
  */
 void abCircleGetBounds(const AbCircle *circle, const Vec2 *circlePos, Region *bounds);
@@ -24,6 +110,85 @@ void abCircleGetBounds(const AbCircle *circle, const Vec2 *circlePos, Region *bo
  */
 int abCircleCheck(const AbCircle *circle, const Vec2 *circlePos, const Vec2 *pixel);
 
+/** Required by AbShape
+ */
+u_int abCircleCoverage(const AbCircle *circle, const Vec2 *circlePos, int col, int row);
+
+/** AbShape ring: the pixels of circle outer that are not in circle inner.
+ *  
+ *  Both circles are centered on the ring's center; inner must be the smaller.
+ */ 
+typedef struct AbAnnulus_s {
+  void (*getBounds)(const struct AbAnnulus_s *ring, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbAnnulus_s *ring, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbAnnulus_s *ring, const Vec2 *centerPos, int col, int row);
+  const AbCircle *outer, *inner;
+} AbAnnulus;
+
+/** Required by AbShape
+ */
+void abAnnulusGetBounds(const AbAnnulus *ring, const Vec2 *centerPos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abAnnulusCheck(const AbAnnulus *ring, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+u_int abAnnulusCoverage(const AbAnnulus *ring, const Vec2 *centerPos, int col, int row);
+
+/** AbShape axis-aligned ellipse
+ *  
+ *  chords should be a vector of length halfHeight + 1.
+ *  Entry at index i is the half width of the row at distance i from the
+ *  ellipse's center (so chords[0] is the half width).  makeCircles
+ *  generates ellipseWxH with half width W and half height H.
+ */ 
+typedef struct AbEllipse_s {
+  void (*getBounds)(const struct AbEllipse_s *ellipse, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbEllipse_s *ellipse, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbEllipse_s *ellipse, const Vec2 *centerPos, int col, int row);
+  const u_char *chords;
+  const u_char halfHeight;
+} AbEllipse;
+
+/** Required by AbShape
+ */
+void abEllipseGetBounds(const AbEllipse *ellipse, const Vec2 *centerPos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abEllipseCheck(const AbEllipse *ellipse, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+u_int abEllipseCoverage(const AbEllipse *ellipse, const Vec2 *centerPos, int col, int row);
+
+/** AbShape rectangle with rounded corners (e.g. paddles and buttons)
+ *  
+ *  Each corner is a quarter of circle corner, whose radius must not
+ *  exceed either axis of halfSize.  halfSize is as for AbRect.
+ */ 
+typedef struct AbRoundRect_s {
+  void (*getBounds)(const struct AbRoundRect_s *rect, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbRoundRect_s *rect, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbRoundRect_s *rect, const Vec2 *centerPos, int col, int row);
+  const Vec2 halfSize;
+  const AbCircle *corner;
+} AbRoundRect;
+
+/** Required by AbShape
+ */
+void abRoundRectGetBounds(const AbRoundRect *rect, const Vec2 *centerPos, Region *bounds);
+
+/** Required by AbShape
+ */
+int abRoundRectCheck(const AbRoundRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** Required by AbShape
+ */
+u_int abRoundRectCoverage(const AbRoundRect *rect, const Vec2 *centerPos, int col, int row);
+
 #endif
 
 
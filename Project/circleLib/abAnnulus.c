@@ -0,0 +1,26 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+// true if pixel is in outer circle but not inner
+int
+abAnnulusCheck(const AbAnnulus *ring, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  return (abCircleCheck(ring->outer, centerPos, pixel) &&
+	  !abCircleCheck(ring->inner, centerPos, pixel));
+}
+
+// pixels col..col+15 of row within ring: outer's span less inner's
+u_int
+abAnnulusCoverage(const AbAnnulus *ring, const Vec2 *centerPos, int col, int row)
+{
+  u_int outer = abCircleCoverage(ring->outer, centerPos, col, row);
+  if (!outer)
+    return 0;
+  return outer & ~abCircleCoverage(ring->inner, centerPos, col, row);
+}
+
+void
+abAnnulusGetBounds(const AbAnnulus *ring, const Vec2 *centerPos, Region *bounds)
+{
+  abCircleGetBounds(ring->outer, centerPos, bounds);
+}
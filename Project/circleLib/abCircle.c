@@ -4,12 +4,17 @@
 // true if pixel is in circle centered at centerPos
 int abCircleCheck(const AbCircle *circle, const Vec2 *centerPos, const Vec2 *pixel)
 {
-  u_char radius = circle->radius;
-  int axis;
-  Vec2 relPos;
-  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
-  vec2Abs(&relPos);		      /* project to first quadrant */
-  return (relPos.axes[0] <= radius && circle->chords[relPos.axes[0]] >= relPos.axes[1]);
+  return abCircleContains(circle, centerPos, pixel);
+}
+
+// pixels col..col+15 of row within circle centered at centerPos
+u_int
+abCircleCoverage(const AbCircle *circle, const Vec2 *centerPos, int col, int row)
+{
+  int halfWidth = abCircleHalfWidth(circle, row - centerPos->axes[1]);
+  if (halfWidth < 0)
+    return 0;
+  return coverageSpan(col, centerPos->axes[0] - halfWidth, centerPos->axes[0] + halfWidth);
 }
   
 void
@@ -20,6 +25,5 @@ abCircleGetBounds(const AbCircle *circle, const Vec2 *centerPos, Region *bounds)
     bounds->topLeft.axes[axis] = centerPos->axes[axis] - radius;
     bounds->botRight.axes[axis] = centerPos->axes[axis] + radius;
   }
-  regionClipScreen(bounds);
 }
 
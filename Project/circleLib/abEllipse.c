@@ -0,0 +1,36 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+// true if pixel is in ellipse centered at centerPos
+int
+abEllipseCheck(const AbEllipse *ellipse, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  Vec2 relPos;
+  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
+  vec2Abs(&relPos);		      /* project to first quadrant */
+  return (relPos.axes[1] <= ellipse->halfHeight &&
+	  ellipse->chords[relPos.axes[1]] >= relPos.axes[0]);
+}
+
+// pixels col..col+15 of row within ellipse: one lookup per row
+u_int
+abEllipseCoverage(const AbEllipse *ellipse, const Vec2 *centerPos, int col, int row)
+{
+  int halfWidth;
+  row -= centerPos->axes[1];
+  row = (row >= 0) ? row : -row;
+  if (row > ellipse->halfHeight)
+    return 0;
+  halfWidth = ellipse->chords[row];
+  return coverageSpan(col, centerPos->axes[0] - halfWidth, centerPos->axes[0] + halfWidth);
+}
+
+void
+abEllipseGetBounds(const AbEllipse *ellipse, const Vec2 *centerPos, Region *bounds)
+{
+  u_char halfWidth = ellipse->chords[0], halfHeight = ellipse->halfHeight;
+  bounds->topLeft.axes[0] = centerPos->axes[0] - halfWidth;
+  bounds->topLeft.axes[1] = centerPos->axes[1] - halfHeight;
+  bounds->botRight.axes[0] = centerPos->axes[0] + halfWidth;
+  bounds->botRight.axes[1] = centerPos->axes[1] + halfHeight;
+}
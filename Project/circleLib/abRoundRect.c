@@ -0,0 +1,42 @@
+#include "shape.h"
+#include "_abCircle.h"
+
+// true if pixel is in rounded rectangle centered at centerPos
+int
+abRoundRectCheck(const AbRoundRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  u_char radius = rect->corner->radius;
+  int cornerCol, cornerRow;
+  Vec2 relPos;
+  vec2Sub(&relPos, pixel, centerPos); /* vector from center to pixel */
+  vec2Abs(&relPos);		      /* project to first quadrant */
+  if (relPos.axes[0] > rect->halfSize.axes[0] || relPos.axes[1] > rect->halfSize.axes[1])
+    return 0;
+  /* position relative to the center of the quarter circle in this corner */
+  cornerCol = relPos.axes[0] - (rect->halfSize.axes[0] - radius);
+  cornerRow = relPos.axes[1] - (rect->halfSize.axes[1] - radius);
+  return (cornerCol <= 0 || cornerRow <= 0 || abCircleChord(rect->corner->chords, cornerCol) >= cornerRow);
+}
+
+// pixels col..col+15 of row within rounded rectangle
+u_int
+abRoundRectCoverage(const AbRoundRect *rect, const Vec2 *centerPos, int col, int row)
+{
+  u_char radius = rect->corner->radius;
+  int halfWidth = rect->halfSize.axes[0], cornerRow;
+  row -= centerPos->axes[1];
+  row = (row >= 0) ? row : -row;
+  if (row > rect->halfSize.axes[1])
+    return 0;
+  cornerRow = row - (rect->halfSize.axes[1] - radius);
+  if (cornerRow > 0)		/* row crosses the corners */
+    halfWidth += abCircleHalfWidth(rect->corner, cornerRow) - radius;
+  return coverageSpan(col, centerPos->axes[0] - halfWidth, centerPos->axes[0] + halfWidth);
+}
+
+void
+abRoundRectGetBounds(const AbRoundRect *rect, const Vec2 *centerPos, Region *bounds)
+{
+  vec2Sub(&bounds->topLeft, centerPos, &rect->halfSize);
+  vec2Add(&bounds->botRight, centerPos, &rect->halfSize);
+}
@@ -0,0 +1,92 @@
+#include <stddef.h>
+#include "shape.h"
+#include "_abCircle.h"
+
+/** A block of the arena: free if refs is 0 */
+typedef struct {
+  u_char size;			/* bytes, including this header; even */
+  u_char refs;			/* users of circle */
+  AbCircle circle;		/* followed by its packed chord and half width tables */
+} CircleBlock;
+
+static u_int arena[CIRCLE_ARENA_SIZE / sizeof(u_int)]; /* u_int keeps blocks aligned */
+static u_char arenaUsed;	/* bytes: blocks beyond are unused */
+
+#define blockAt(offset) ((CircleBlock *)((u_char *)arena + (offset)))
+
+const AbCircle *
+abCircleNew(u_char radius)
+{
+  u_char offset, fit = CIRCLE_ARENA_SIZE;
+  /* header, circle, then each table's group count and radius + 1 entries */
+  u_int size = (sizeof(CircleBlock) + 2 * (radius + 2) + 1) & ~1;
+  CircleBlock *b;
+  u_char *chords, *widths;
+
+  if (size > CIRCLE_ARENA_SIZE)
+    return 0;
+
+  for (offset = 0; offset < arenaUsed; offset += b->size) {
+    b = blockAt(offset);
+    if (b->refs) {
+      if (b->circle.radius == radius) { /* already built */
+	b->refs++;
+	return &b->circle;
+      }
+      continue;
+    }
+    while (offset + b->size < arenaUsed && !blockAt(offset + b->size)->refs)
+      b->size += blockAt(offset + b->size)->size; /* merge following free blocks */
+    if (fit == CIRCLE_ARENA_SIZE && b->size >= size)
+      fit = offset;		/* first free block that fits */
+  }
+  if (fit == CIRCLE_ARENA_SIZE) {	/* none: take from the unused end */
+    if (arenaUsed > CIRCLE_ARENA_SIZE - size)
+      return 0;
+    fit = arenaUsed;
+    arenaUsed += size;
+    blockAt(fit)->size = size;
+  } else if (blockAt(fit)->size >= size + sizeof(CircleBlock)) {
+    CircleBlock *rest = blockAt(fit + size); /* split off the remainder */
+    rest->size = blockAt(fit)->size - size;
+    rest->refs = 0;
+    blockAt(fit)->size = size;
+  }
+
+  b = blockAt(fit);
+  chords = (u_char *)(b + 1);
+  chords[0] = 0;		/* no groups: a plain table follows */
+  computeChordVec(chords + 1, radius);
+  widths = chords + radius + 2;
+  widths[0] = 0;
+  computeHalfWidths(widths + 1, chords + 1, radius);
+  b->refs = 1;
+  b->circle.getBounds = abCircleGetBounds;
+  b->circle.check = abCircleCheck;
+  b->circle.coverage = abCircleCoverage;
+  b->circle.chords = chords;
+  b->circle.widths = widths;
+  *(u_char *)&b->circle.radius = radius; /* const to users, not to the arena */
+  return &b->circle;
+}
+
+void
+abCircleRelease(const AbCircle *circle)
+{
+  const u_char *p = (const u_char *)circle;
+  CircleBlock *b;
+  if (p < (u_char *)arena || p >= (u_char *)arena + arenaUsed)
+    return;			/* not from the arena */
+  b = (CircleBlock *)(p - offsetof(CircleBlock, circle));
+  if (!b->refs)			/* already released */
+    return;
+  b->refs--;
+  for (;;) {			/* give trailing free blocks back to the end */
+    u_char offset, last = 0;
+    for (offset = 0; offset < arenaUsed; offset += blockAt(offset)->size)
+      last = offset;
+    if (!arenaUsed || blockAt(last)->refs)
+      break;
+    arenaUsed = last;
+  }
+}
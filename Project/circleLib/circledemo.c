@@ -3,27 +3,58 @@
 #include <lcddraw.h>
 #include "abCircle.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}};; /**< 10x10 rectangle */
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectCoverage, {10,10}};; /**< 10x10 rectangle */
+const AbAnnulus ring = {abAnnulusGetBounds, abAnnulusCheck, abAnnulusCoverage, &circle12, &circle8};
+const AbRoundRect paddle = {abRoundRectGetBounds, abRoundRectCheck, abRoundRectCoverage, {20,5}, &circle4};
 
 u_int bgColor = COLOR_BLUE;
 
 
-Layer layer1 = {		/**< Layer with a red square */
-  (AbShape *)&rect10,
-  {screenWidth/2, screenHeight/2}, /**< center */
-  {0,0}, {0,0},				    /* next & last pos */
-  COLOR_RED,
+const LayerDesc redSquare = {(const AbShape *)&rect10, COLOR_RED};
+const LayerDesc orangeCircle = {(const AbShape *)&circle14, COLOR_ORANGE};
+const LayerDesc yellowRing = {(const AbShape *)&ring, COLOR_YELLOW};
+const LayerDesc greenEllipse = {(const AbShape *)&ellipse16x8, COLOR_GREEN};
+const LayerDesc whitePaddle = {(const AbShape *)&paddle, COLOR_WHITE};
+
+Layer layer4 = {		/**< Layer with a white rounded-rect paddle */
+  &whitePaddle,
+  pvec2(screenWidth/2, screenHeight-15), /**< near bottom */
+  0, 0,					    /* next & last pos */
   0
 };
 
+Layer layer3 = {		/**< Layer with a green ellipse */
+  &greenEllipse,
+  pvec2(screenWidth-30, 40),		    /**< upper right */
+  0, 0,					    /* next & last pos */
+  &layer4
+};
+
+Layer layer2 = {		/**< Layer with a yellow ring */
+  &yellowRing,
+  pvec2(30, 40),			    /**< upper left */
+  0, 0,					    /* next & last pos */
+  &layer3
+};
+
+Layer layer1 = {		/**< Layer with a red square */
+  &redSquare,
+  pvec2(screenWidth/2, screenHeight/2), /**< center */
+  0, 0,					    /* next & last pos */
+  &layer2
+};
+
 Layer layer0 = {		/**< Layer with an orange circle */
-  (AbShape *)&circle14,
-  {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {0,0}, {0,0},				    /* next & last pos */
-  COLOR_ORANGE,
+  &orangeCircle,
+  pvec2((screenWidth/2)+10, (screenHeight/2)+5), /**< bit below & right of center */
+  0, 0,					    /* next & last pos */
   &layer1,
 };
 
+#define BUBBLES 4
+LayerDesc bubbleDescs[BUBBLES];	/**< shapes built at runtime, so in RAM */
+Layer bubbles[BUBBLES];		/**< drawn in front of layer0 */
+
 int
 main()
 {
@@ -33,6 +64,19 @@ main()
   clearScreen(COLOR_BLUE);
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
 
-  layerDraw(&layer0);
+  {				/* bubbles of assorted radii from the circle arena */
+    static const u_char radii[BUBBLES] = {3, 6, 3, 9}; /* the two 3s share a circle */
+    u_char i;
+    for (i = 0; i < BUBBLES; i++) {
+      const AbCircle *circle = abCircleNew(radii[i]);
+      bubbleDescs[i].abShape = circle ? (const AbShape *)circle : (const AbShape *)&circle4; /* arena full */
+      bubbleDescs[i].color = COLOR_WHITE;
+      bubbles[i].desc = &bubbleDescs[i];
+      bubbles[i].pos = pvec2(20 + 25 * i, screenHeight - 40);
+      bubbles[i].next = (i < BUBBLES - 1) ? &bubbles[i + 1] : &layer0;
+    }
+  }
+
+  layerDraw(bubbles);
 
 }
@@ -0,0 +1,54 @@
+
+#include "computeChordVec.h"
+
+///////////////////////////////////////////
+// build table chordVec[d] of circle 1/2 widths at distances d from center
+// Code adapted from RobG's EduKit
+// Uses Bresenham's circle algorithm
+// Modified from RobG's EduKit by Eric Freudenthal and David Pruitt 2016
+///////////////////////////////////////////
+void computeChordVec(unsigned char chordVec[], unsigned char radius) 
+{
+  int col = radius, row = 0;	/* first coordinate (radius, 0) */
+  
+  // key insight: (col+1)**2 - col**2 = 2col+1
+  
+  int dColSquared = 2 * col - 1;  // change in col**2 for a unit decrease in col
+  int dRowSquared = 1;	    // change in row**2 for a unit increase in row
+
+  int radiusSqErr = 0;		/* (radius, 0) is on the circle  */
+  int colPrev = 0;		/* initially bogus value  to force first entry*/
+  while (col >= row) {		/* only sweep first octant */
+    chordVec[row] = col;      /* row always changes in first octant */
+
+    /* mirror into 2nd octant */
+    if (colPrev != col)		/* col sometimes repeats in first octant */
+      chordVec[col] = row;	/* only save first (max) col for row */
+    colPrev = col;
+
+    row++;			/* move vertically (slope <= -1 for first octant) */
+    radiusSqErr += dRowSquared;	/* current radiusSqErr */
+    dRowSquared += 2; 		/* next dRowSquared */
+    if ((2 * radiusSqErr) > dColSquared) { /* only update col if error reduced */
+      col--;			/* move horizontally */
+      radiusSqErr -= dColSquared;	/* current radiusSqErr */
+      dColSquared -= 2;	      /* next dColSquared */
+    }
+  }
+}
+
+///////////////////////////////////////////
+// build table widths[d] of circle 1/2 widths of the rows at distances d
+// from center: the widest col whose chord (from computeChordVec) reaches
+// the row.  Chords are not symmetric under swapping rows and cols, so
+// this is not chordVec itself.
+///////////////////////////////////////////
+void computeHalfWidths(unsigned char widths[], const unsigned char chordVec[], unsigned char radius)
+{
+  int row, col = radius;
+  for (row = 0; row <= radius; row++) {
+    while (col > 0 && chordVec[col] < row)
+      col--;			/* widths never increase moving away from center */
+    widths[row] = col;
+  }
+}
@@ -0,0 +1,17 @@
+/** \file computeChordVec.h
+ *  \brief Circle chord tables, shared by makeCircles (on the host) and libCircle.
+ */
+#ifndef computeChordVec_included
+#define computeChordVec_included
+
+/** Fill chordVec[0..radius] with the 1/2 chords of a circle of radius
+ *  (Bresenham's circle algorithm; see computeChordVec.c)
+ */
+void computeChordVec(unsigned char chordVec[], unsigned char radius);
+
+/** Fill widths[0..radius] with the 1/2 widths of the rows of the circle
+ *  whose chords are chordVec: the widest column whose chord reaches each
+ */
+void computeHalfWidths(unsigned char widths[], const unsigned char chordVec[], unsigned char radius);
+
+#endif // computeChordVec_included
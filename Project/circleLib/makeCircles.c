@@ -1,50 +1,182 @@
+#include "computeChordVec.h"	/* shared with the runtime circle arena */
 
 ///////////////////////////////////////////
-// build table chordVec[d] of circle 1/2 widths at distances d from center
-// Code adapted from RobG's EduKit
-// Uses Bresenham's circle algorithm
-// Modified from RobG's EduKit by Eric Freudenthal and David Pruitt 2016
+// build table chords[d] of ellipse 1/2 widths at distances d (rows) from center
+// Pixel (x, y) is inside if x*x/(a*a) + y*y/(b*b) <= 1 + (a+b)/(2*a*b),
+// which for a == b is x*x + y*y <= r*r + r, like the circles above.
 ///////////////////////////////////////////
-void computeChordVec(unsigned char chordVec[], unsigned char radius) 
+void computeEllipseChords(unsigned char chords[], unsigned char halfWidth, unsigned char halfHeight)
 {
-  int col = radius, row = 0;	/* first coordinate (radius, 0) */
-  
-  // key insight: (col+1)**2 - col**2 = 2col+1
-  
-  int dColSquared = 2 * col - 1;  // change in col**2 for a unit decrease in col
-  int dRowSquared = 1;	    // change in row**2 for a unit increase in row
-
-  int radiusSqErr = 0;		/* (radius, 0) is on the circle  */
-  int colPrev = 0;		/* initially bogus value  to force first entry*/
-  while (col >= row) {		/* only sweep first octant */
-    chordVec[row] = col;      /* row always changes in first octant */
-
-    /* mirror into 2nd octant */
-    if (colPrev != col)		/* col sometimes repeats in first octant */
-      chordVec[col] = row;	/* only save first (max) col for row */
-    colPrev = col;
-
-    row++;			/* move vertically (slope <= -1 for first octant) */
-    radiusSqErr += dRowSquared;	/* current radiusSqErr */
-    dRowSquared += 2; 		/* next dRowSquared */
-    if ((2 * radiusSqErr) > dColSquared) { /* only update col if error reduced */
-      col--;			/* move horizontally */
-      radiusSqErr -= dColSquared;	/* current radiusSqErr */
-      dColSquared -= 2;	      /* next dColSquared */
-    }
+  long a = halfWidth, b = halfHeight;
+  long limit = 2*a*a*b*b + a*b*(a+b); /* doubled to stay integral */
+  int row, col = halfWidth;
+  for (row = 0; row <= halfHeight; row++) {
+    while (col > 0 && 2*(col*col*b*b + row*row*a*a) > limit)
+      col--;			/* widths never increase moving away from center */
+    chords[row] = col;
   }
 }
 
 #include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
 #include "assert.h"
 
+/** Ellipses to generate: half width, half height */
+static const unsigned char ellipseSizes[][2] = {
+  {4,2}, {6,3}, {8,4}, {8,5}, {10,5}, {12,6}, {12,8}, {16,8}, {20,10}, {24,12},
+  {2,4}, {3,6}, {4,8}, {5,10}, {6,12}, {8,16},
+};
+
+
+#define RADIUS_MIN 2
+#define RADIUS_MAX 150
+#define CHORD_GROUP 8		/* as in _abCircle.h */
+#define PATTERNS_MAX 256	/* patterns are named by a byte */
+#define GROUPS_MAX (RADIUS_MAX / CHORD_GROUP + 1)
+
+unsigned char chordTables[RADIUS_MAX + 1][RADIUS_MAX + 1]; /* by radius */
+unsigned char widthTables[RADIUS_MAX + 1][RADIUS_MAX + 1]; /* by radius: 1/2 width of each row */
+
+/** The tables packed into chordBlob, and the names of their tables */
+#define KINDS 2
+unsigned char (*const kindTables[KINDS])[RADIUS_MAX + 1] = {chordTables, widthTables};
+const char *const kindNames[KINDS] = {"chord", "width"};
+
+/** Distinct patterns of drops within a group, and how many groups have each */
+unsigned char patterns[KINDS * (RADIUS_MAX + 1) * GROUPS_MAX][CHORD_GROUP];
+int patternCounts[KINDS * (RADIUS_MAX + 1) * GROUPS_MAX], patternCount;
+int patternOrder[KINDS * (RADIUS_MAX + 1) * GROUPS_MAX]; /* most used first */
+int patternNames[KINDS * (RADIUS_MAX + 1) * GROUPS_MAX]; /* byte naming each, or -1 */
+
+// drops from chords[first] to each chord of its group (the last chord repeats past the end)
+void groupDrops(unsigned char drops[], const unsigned char chords[], int radius, int first)
+{
+  int i;
+  for (i = 0; i < CHORD_GROUP; i++) {
+    int at = first + i <= radius ? first + i : radius;
+    drops[i] = chords[first] - chords[at];
+  }
+}
+
+// index of pattern drops, adding it if new
+int findPattern(const unsigned char drops[])
+{
+  int p;
+  for (p = 0; p < patternCount; p++)
+    if (!memcmp(patterns[p], drops, CHORD_GROUP))
+      return p;
+  memcpy(patterns[patternCount], drops, CHORD_GROUP);
+  patternCounts[patternCount] = 0;
+  return patternCount++;
+}
+
+int byCountDescending(const void *a, const void *b)
+{
+  return patternCounts[*(const int *)b] - patternCounts[*(const int *)a];
+}
+
+// Pack chordTables and widthTables into chordBlob.c (see _abCircle.h for the format)
+void packChordTables(FILE *chordIncludeFile)
+{
+  unsigned int offsets[KINDS][RADIUS_MAX + 1], offset = 0, raw = 0;
+  int radius, p, names, kind;
+  unsigned char drops[CHORD_GROUP];
+  FILE *fp = fopen("circles/chordBlob.c", "w");
+  assert(fp);
+
+  for (kind = 0; kind < KINDS; kind++)	/* count patterns */
+    for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++) {
+      int first;
+      for (first = 0; first <= radius; first += CHORD_GROUP) {
+	groupDrops(drops, kindTables[kind][radius], radius, first);
+	patternCounts[findPattern(drops)]++;
+      }
+    }
+  for (p = 0; p < patternCount; p++)
+    patternOrder[p] = p;
+  qsort(patternOrder, patternCount, sizeof(int), byCountDescending);
+  names = patternCount < PATTERNS_MAX ? patternCount : PATTERNS_MAX;
+  for (p = 0; p < patternCount; p++)
+    patternNames[p] = -1;
+  for (p = 0; p < names; p++)
+    patternNames[patternOrder[p]] = p;
+
+  fprintf(fp, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
+  fprintf(fp, "#include \"abCircle.h\"\n\n");
+  fprintf(fp, "#include \"chordVec.h\"\n\n");
+  fprintf(fp, "const unsigned char chordDrops[%d][CHORD_GROUP] = {\n", names);
+  for (p = 0; p < names; p++) {
+    int i;
+    fprintf(fp, "  {");
+    for (i = 0; i < CHORD_GROUP; i++)
+      fprintf(fp, "%d%s", patterns[patternOrder[p]][i], i < CHORD_GROUP - 1 ? "," : "");
+    fprintf(fp, "},\n");
+  }
+  fprintf(fp, "};\n\n");
+
+  fprintf(fp, "const unsigned char chordBlob[] = {\n");
+  for (kind = 0; kind < KINDS; kind++)
+    for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++) {
+      const unsigned char *chords = kindTables[kind][radius];
+      int groups = 0, first, i;
+      for (first = 0; first <= radius; first += CHORD_GROUP, groups++) {
+	groupDrops(drops, chords, radius, first);
+	if (patternNames[findPattern(drops)] < 0)
+	  break;		/* rest are raw */
+      }
+      offsets[kind][radius] = offset;
+      fprintf(fp, "  // %ss of radius %d\n  %d,\n", kindNames[kind], radius, groups);
+      for (first = 0; first < groups * CHORD_GROUP; first += CHORD_GROUP) {
+	groupDrops(drops, chords, radius, first);
+	fprintf(fp, "  %d, %d, // dist along axis = %d..\n", chords[first],
+		patternNames[findPattern(drops)], first);
+      }
+      for (i = groups * CHORD_GROUP; i <= radius; i++)
+	fprintf(fp, "  %d, // dist along axis = %d\n", chords[i], i);
+      offset += 1 + 2 * groups;
+      if (groups * CHORD_GROUP <= radius)
+	offset += radius + 1 - groups * CHORD_GROUP; /* raw entries */
+      raw += radius + 1;
+    }
+  fprintf(fp, "};\n\n");
+
+  for (kind = 0; kind < KINDS; kind++) {
+    fprintf(fp, "const unsigned int %sIndex[%d] = {\n", kindNames[kind], RADIUS_MAX - RADIUS_MIN + 1);
+    for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++)
+      fprintf(fp, "  %d, // radius %d\n", offsets[kind][radius], radius);
+    fprintf(fp, "};\n\n");
+  }
+  fprintf(fp, "// %d bytes of chords and widths packed into %d bytes of chordBlob and %d of chordDrops\n",
+	  raw, offset, names * CHORD_GROUP);
+  fclose(fp);
+
+  fprintf(chordIncludeFile, "#define CHORD_RADIUS_MIN %d\n", RADIUS_MIN);
+  fprintf(chordIncludeFile, "#define CHORD_RADIUS_MAX %d\n\n", RADIUS_MAX);
+  fprintf(chordIncludeFile, "/** Every circle's packed chord and half width tables, and the offset of each radius's */\n");
+  fprintf(chordIncludeFile, "extern const unsigned char chordBlob[%d];\n", offset);
+  for (kind = 0; kind < KINDS; kind++)
+    fprintf(chordIncludeFile, "extern const unsigned int %sIndex[%d];\n", kindNames[kind],
+	    RADIUS_MAX - RADIUS_MIN + 1);
+  fprintf(chordIncludeFile, "\n/** Packed chord and half width tables of a circle with radius (from CHORD_RADIUS_MIN to MAX) */\n");
+  for (kind = 0; kind < KINDS; kind++)
+    fprintf(chordIncludeFile, "#define %sVecOf(radius) (chordBlob + %sIndex[(radius) - CHORD_RADIUS_MIN])\n",
+	    kindNames[kind], kindNames[kind]);
+  fprintf(chordIncludeFile, "\n");
+  for (kind = 0; kind < KINDS; kind++)
+    for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++)
+      fprintf(chordIncludeFile, "#define %sVec%d (chordBlob + %d)\n", kindNames[kind], radius,
+	      offsets[kind][radius]);
+  fprintf(chordIncludeFile, "\n");
+}
 
 // Generate circles as source files
 // (c) Eric Freudenthal, 2016
 int main()
 {
   int radius;
-  char chordVec[151];
+  unsigned index;
+  unsigned char chordVec[151];
   FILE *circleIncludeFile = fopen("abCircle_decls.h", "w");
   FILE *chordIncludeFile = fopen("chordVec.h", "w");
   assert(chordIncludeFile); assert(circleIncludeFile);
@@ -55,38 +187,58 @@ int main()
   fprintf(chordIncludeFile, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
   fprintf(chordIncludeFile, "#ifndef chordVec_included\n#define chordVec_included\n\n");
 
-  for (radius = 2; radius <= 150; radius++) {
+  for (radius = RADIUS_MIN; radius <= RADIUS_MAX; radius++) {
     char filename[100];
-    unsigned char chordIndex;
     
-    computeChordVec(chordVec, radius);
+    computeChordVec(chordTables[radius], radius);
+    computeHalfWidths(widthTables[radius], chordTables[radius], radius);
 
-    {				/* chordVecN.c */
-      sprintf(filename, "circles/chordVec%d.c", radius);
+    {				/* abCircleN.c */
+      sprintf(filename, "circles/abCircle%d.c", radius);
       FILE *fp = fopen(filename, "w");
       assert(fp);
       fprintf(fp, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
+      fprintf(fp, "#include \"abCircle.h\"\n\n");
       fprintf(fp, "#include \"chordVec.h\"\n\n");
-      fprintf(fp, "const unsigned char chordVec%d[%d] = {\n", radius, radius+1);
-      for (chordIndex = 0; chordIndex <= radius; chordIndex ++) 
-	fprintf(fp, "    %d, // dist along axis = %d\n", chordVec[chordIndex], chordIndex);
-      fprintf(fp, "};\n\n");
+      fprintf(fp, "const AbCircle circle%d = {" , radius);
+      fprintf(fp, "  abCircleGetBounds, abCircleCheck, abCircleCoverage, chordVec%d, widthVec%d, %d",
+	      radius, radius, radius);
+      fprintf(fp, "};\n");
       fclose(fp);
-    } {				/* abCircleN.c */
-      sprintf(filename, "circles/abCircle%d.c", radius);
+    }
+    				/* includes */
+    fprintf(circleIncludeFile, "extern const AbCircle circle%d;\n" , radius);
+  }
+  packChordTables(chordIncludeFile);
+
+  for (index = 0; index < sizeof(ellipseSizes) / sizeof(ellipseSizes[0]); index++) {
+    int halfWidth = ellipseSizes[index][0], halfHeight = ellipseSizes[index][1];
+    char filename[100];
+    unsigned char chordIndex;
+    
+    computeEllipseChords(chordVec, halfWidth, halfHeight);
+
+    {				/* ellipseWxH.c: chords and shape together */
+      sprintf(filename, "circles/ellipse%dx%d.c", halfWidth, halfHeight);
       FILE *fp = fopen(filename, "w");
       assert(fp);
       fprintf(fp, "// Automatically generated by makeCircles.  (c) Eric Freudenthal, 2016\n");
       fprintf(fp, "#include \"abCircle.h\"\n\n");
       fprintf(fp, "#include \"chordVec.h\"\n\n");
-      fprintf(fp, "const AbCircle circle%d = {" , radius);
-      fprintf(fp, "  abCircleGetBounds, abCircleCheck, chordVec%d, %d", radius, radius);
+      fprintf(fp, "const unsigned char ellipseChords%dx%d[%d] = {\n", halfWidth, halfHeight, halfHeight+1);
+      for (chordIndex = 0; chordIndex <= halfHeight; chordIndex ++) 
+	fprintf(fp, "    %d, // dist along row axis = %d\n", chordVec[chordIndex], chordIndex);
+      fprintf(fp, "};\n\n");
+      fprintf(fp, "const AbEllipse ellipse%dx%d = {" , halfWidth, halfHeight);
+      fprintf(fp, "  abEllipseGetBounds, abEllipseCheck, abEllipseCoverage, ellipseChords%dx%d, %d",
+	      halfWidth, halfHeight, halfHeight);
       fprintf(fp, "};\n");
       fclose(fp);
     }
     				/* includes */
-    fprintf(chordIncludeFile, "extern const unsigned char chordVec%d[%d];\n", radius, radius+1);
-    fprintf(circleIncludeFile, "extern const AbCircle circle%d;\n" , radius);
+    fprintf(chordIncludeFile, "extern const unsigned char ellipseChords%dx%d[%d];\n",
+	    halfWidth, halfHeight, halfHeight+1);
+    fprintf(circleIncludeFile, "extern const AbEllipse ellipse%dx%d;\n" , halfWidth, halfHeight);
   }
 
   fprintf(circleIncludeFile, "\n#endif // included \n");
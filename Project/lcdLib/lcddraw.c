@@ -95,6 +95,29 @@ void drawString5x7(u_char col, u_char row, char *string,
 }
 
 
+/** Format a number for drawString5x7
+ *  Right justified, with leading spaces; only its last width digits
+ *  are kept if it has more.
+ *
+ *  \param buf The string, at least width + 1 chars
+ *  \param n The number
+ *  \param width Characters before the terminating 0
+ */
+void formatNum(char *buf, unsigned long n, u_char width)
+{
+  char *c = buf + width;
+  *c = 0;
+  while (c > buf) {
+    *--c = '0' + n % 10;
+    n /= 10;
+    if (!n)
+      break;
+  }
+  while (c > buf)
+    *--c = ' ';
+}
+
+
 /** Draw rectangle outline
  *  
  *  \param colMin Column start
@@ -44,6 +44,16 @@ void clearScreen(u_int colorBGR);
 void drawString5x7(u_char col, u_char row, char *string, 
 		   u_int fgColorBGR, u_int bgColorBGR);
 
+/** Format a number for drawString5x7
+ *  Right justified, with leading spaces; only its last width digits
+ *  are kept if it has more.
+ *
+ *  \param buf The string, at least width + 1 chars
+ *  \param n The number
+ *  \param width Characters before the terminating 0
+ */
+void formatNum(char *buf, unsigned long n, u_char width);
+
 /** 5x7 font - this function draws background pixels
  *  Adapted from RobG's EduKit
  */
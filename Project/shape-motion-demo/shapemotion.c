@@ -12,142 +12,85 @@
 #include <lcddraw.h>
 #include <p2switches.h>
 #include <shape.h>
+#include <layerTable.h>
+#include <path.h>
 #include <abCircle.h>
 
 #define GREEN_LED BIT6
 
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, {10,10}}; /**< 10x10 rectangle */
-AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, 30};
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectCoverage, {10,10}}; /**< 10x10 rectangle */
+const AbRArrow rightArrow = {abRArrowGetBounds, abRArrowCheck, abRArrowCoverage, 30};
 
-AbRectOutline fieldOutline = {	/* playing field */
-  abRectOutlineGetBounds, abRectOutlineCheck,   
+const AbRectOutline fieldOutline = {	/* playing field */
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineCoverage,
   {screenWidth/2 - 10, screenHeight/2 - 10}
 };
 
+const LayerDesc pinkArrow = {(const AbShape *)&rightArrow, COLOR_PINK};
+const LayerDesc violetCircle = {(const AbShape *)&circle8, COLOR_VIOLET};
+const LayerDesc blackField = {(const AbShape *)&fieldOutline, COLOR_BLACK};
+const LayerDesc redSquare = {(const AbShape *)&rect10, COLOR_RED};
+const LayerDesc orangeCircle = {(const AbShape *)&circle14, COLOR_ORANGE};
+
 Layer layer4 = {
-  (AbShape *)&rightArrow,
-  {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_PINK,
+  &pinkArrow,
+  pvec2((screenWidth/2)+10, (screenHeight/2)+5), /**< bit below & right of center */
+  0, 0,					    /* last & next pos */
   0
 };
   
 
-Layer layer3 = {		/**< Layer with an orange circle */
-  (AbShape *)&circle8,
-  {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_VIOLET,
+Layer layer3 = {		/**< Layer with a violet circle */
+  &violetCircle,
+  pvec2((screenWidth/2)+10, (screenHeight/2)+5), /**< bit below & right of center */
+  0, 0,					    /* last & next pos */
   &layer4,
 };
 
 
 Layer fieldLayer = {		/* playing field as a layer */
-  (AbShape *) &fieldOutline,
-  {screenWidth/2, screenHeight/2},/**< center */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_BLACK,
+  &blackField,
+  pvec2(screenWidth/2, screenHeight/2),/**< center */
+  0, 0,					    /* last & next pos */
   &layer3
 };
 
 Layer layer1 = {		/**< Layer with a red square */
-  (AbShape *)&rect10,
-  {screenWidth/2, screenHeight/2}, /**< center */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_RED,
+  &redSquare,
+  pvec2(screenWidth/2, screenHeight/2), /**< center */
+  0, 0,					    /* last & next pos */
   &fieldLayer,
 };
 
 Layer layer0 = {		/**< Layer with an orange circle */
-  (AbShape *)&circle14,
-  {(screenWidth/2)+10, (screenHeight/2)+5}, /**< bit below & right of center */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_ORANGE,
+  &orangeCircle,
+  pvec2((screenWidth/2)+10, (screenHeight/2)+5), /**< bit below & right of center */
+  0, 0,					    /* last & next pos */
   &layer1,
 };
 
-/** Moving Layer
- *  Linked list of layer references
- *  Velocity represents one iteration of change (direction & magnitude)
- */
-typedef struct MovLayer_s {
-  Layer *layer;
-  Vec2 velocity;
-  struct MovLayer_s *next;
-} MovLayer;
-
-/* initial value of {0,0} will be overwritten */
-MovLayer ml3 = { &layer3, {1,1}, 0 }; /**< not all layers move */
-MovLayer ml1 = { &layer1, {1,2}, &ml3 }; 
-MovLayer ml0 = { &layer0, {2,1}, &ml1 }; 
-
-void movLayerDraw(MovLayer *movLayers, Layer *layers)
-{
-  int row, col;
-  MovLayer *movLayer;
-
-  and_sr(~8);			/**< disable interrupts (GIE off) */
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Layer *l = movLayer->layer;
-    l->posLast = l->pos;
-    l->pos = l->posNext;
-  }
-  or_sr(8);			/**< disable interrupts (GIE on) */
-
-
-  for (movLayer = movLayers; movLayer; movLayer = movLayer->next) { /* for each moving layer */
-    Region bounds;
-    layerGetBounds(movLayer->layer, &bounds);
-    lcd_setArea(bounds.topLeft.axes[0], bounds.topLeft.axes[1], 
-		bounds.botRight.axes[0], bounds.botRight.axes[1]);
-    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
-      for (col = bounds.topLeft.axes[0]; col <= bounds.botRight.axes[0]; col++) {
-	Vec2 pixelPos = {col, row};
-	u_int color = bgColor;
-	Layer *probeLayer;
-	for (probeLayer = layers; probeLayer; 
-	     probeLayer = probeLayer->next) { /* probe all layers, in order */
-	  if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	    color = probeLayer->color;
-	    break; 
-	  } /* if probe check */
-	} // for checking all layers at col, row
-	lcd_writeColor(color); 
-      } // for col
-    } // for row
-  } // for moving layer being updated
-}	  
-
-
+LayerTable layers;		/**< all layers, in z order, with their motion */
 
-//Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}}; /**< Create a fence region */
+const PathPoint arrowPath[] = {	/**< round the field, easing in and out at each corner */
+  {{40, 50}, 60, PATH_EASE_IN_OUT},
+  {{88, 50}, 60, PATH_EASE_IN_OUT},
+  {{88, 110}, 60, PATH_EASE_IN_OUT},
+  {{40, 110}, 60, PATH_EASE_IN_OUT},
+};
+PathFollower arrowFollower;	/**< moves layer4 along arrowPath */
 
-/** Advances a moving shape within a fence
- *  
- *  \param ml The moving shape to be advanced
- *  \param fence The region which will serve as a boundary for ml
- */
-void mlAdvance(MovLayer *ml, Region *fence)
+/** Redraw the moving layers at their new positions */
+void movLayerDraw(LayerTable *t)
 {
-  Vec2 newPos;
-  u_char axis;
-  Region shapeBoundary;
-  for (; ml; ml = ml->next) {
-    vec2Add(&newPos, &ml->layer->posNext, &ml->velocity);
-    abShapeGetBounds(ml->layer->abShape, &newPos, &shapeBoundary);
-    for (axis = 0; axis < 2; axis ++) {
-      if ((shapeBoundary.topLeft.axes[axis] < fence->topLeft.axes[axis]) ||
-	  (shapeBoundary.botRight.axes[axis] > fence->botRight.axes[axis]) ) {
-	int velocity = ml->velocity.axes[axis] = -ml->velocity.axes[axis];
-	newPos.axes[axis] += (2*velocity);
-      }	/**< if outside of fence */
-    } /**< for axis */
-    ml->layer->posNext = newPos;
-  } /**< for ml */
+  layerTableCommit(t);		/**< copies the positions last advanced */
+  layerTableDrawMoving(t);
 }
 
 
+//Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}}; /**< Create a fence region */
+
+
 u_int bgColor = COLOR_BLUE;     /**< The background color */
 int redrawScreen = 1;           /**< Boolean for whether screen needs to be redrawn */
 
@@ -169,8 +112,31 @@ void main()
 
   shapeInit();
 
-  layerInit(&layer0);
-  layerDraw(&layer0);
+  layerTableInit(&layers);	/**< front to back */
+  layerTableSetVelocity(&layers, layerTableInsert(&layers, &layer0), LAYER_Q8(2)/3, LAYER_Q8(1)/3);
+  {
+    u_char slot = layerTableInsert(&layers, &layer1);
+    layerTableSetVelocity(&layers, slot, LAYER_Q8(1)/3, LAYER_Q8(2)/3);
+    layerTableSetFence(&layers, slot, LAYER_FENCE_WRAP); /**< leaves one side, returns the other */
+  }
+  layerTableInsert(&layers, &fieldLayer);
+  layerTableSetVelocity(&layers, layerTableInsert(&layers, &layer3), LAYER_Q8(0.25), LAYER_Q8(0.25));
+  {
+    u_char slot = layerTableInsert(&layers, &layer4);
+    /* the others bounce off it.  Moved by its path, it isn't swept, so
+       when it moves onto one, advance pushes that one out of it. */
+    layerTableSetSolid(&layers, slot);
+    pathFollow(&arrowFollower, &layers, slot, arrowPath, 4, 1);
+  }
+  layerTablePaint(&layers);
+
+  {				/**< estimate RAM saved by flash-resident shapes & packed layers */
+    char ramSaved[6];
+    itoa(layerRamSavedEstimate(&layer0, sizeof(rect10) + sizeof(rightArrow) + sizeof(fieldOutline)),
+	 ramSaved, 10);
+    drawString5x7(2, screenHeight - 8, "Est. saved:", COLOR_WHITE, bgColor);
+    drawString5x7(70, screenHeight - 8, ramSaved, COLOR_WHITE, bgColor);
+  }
 
 
   layerGetBounds(&fieldLayer, &fieldFence);
@@ -187,7 +153,7 @@ void main()
     }
     P1OUT |= GREEN_LED;       /**< Green led on when CPU on */
     redrawScreen = 0;
-    movLayerDraw(&ml0, &layer0);
+    movLayerDraw(&layers);
   }
 }
 
@@ -197,9 +163,10 @@ void wdt_c_handler()
   static short count = 0;
   P1OUT |= GREEN_LED;		      /**< Green LED on when cpu on */
   count ++;
-  if (count == 15) {
-    mlAdvance(&ml0, &fieldFence);
-    if (p2sw_read())
+  if (count == 5) {		/**< a third of a pixel at a time, 3x as often */
+    pathAdvance(&arrowFollower, 1, &layers);
+    layerTableAdvance(&layers, &fieldFence);
+    if (layers.dirty && p2sw_read()) /**< only when a layer reaches a new pixel */
       redrawScreen = 1;
     count = 0;
   } 
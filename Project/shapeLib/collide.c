@@ -0,0 +1,92 @@
+#include "collide.h"
+
+void
+collideInit(Collider *c)
+{
+  c->count = 0;
+}
+
+int
+collideShapes(const AbShape *a, const Vec2 *centerA,
+	      const AbShape *b, const Vec2 *centerB, const Region *area)
+{
+  int row, col, right = area->botRight.axes[0];
+  for (row = area->topLeft.axes[1]; row <= area->botRight.axes[1]; row++) {
+    for (col = area->topLeft.axes[0]; col <= right; col += 16) {
+      u_int word = coverageSpan(col, col, right);
+      word &= abShapeCoverage(a, centerA, col, row);
+      if (word && (word & abShapeCoverage(b, centerB, col, row)))
+	return 1;
+    }
+  }
+  return 0;
+}
+
+/** Keep the slots of order[] still in mask, then append the new ones */
+static void
+collideUpdateCandidates(Collider *c, u_int mask)
+{
+  u_char from, to = 0, slot;
+  for (from = 0; from < c->count; from++) {
+    u_int slotBit = layerTableBit(c->order[from]);
+    if (mask & slotBit) {
+      c->order[to++] = c->order[from];
+      mask &= ~slotBit;		/* already a candidate */
+    }
+  }
+  for (slot = 0; mask; slot++, mask >>= 1)
+    if (mask & 1)
+      c->order[to++] = slot;
+  c->count = to;
+}
+
+u_char
+collideLayers(Collider *c, const LayerTable *t, u_int mask, CollideContact contact)
+{
+  PRegion bounds[LAYER_TABLE_SIZE];	/* by slot, packed */
+  u_char i, j, contacts = 0;
+
+  collideUpdateCandidates(c, mask & t->used);
+  for (i = 0; i < c->count; i++) {	/* bounds of each candidate, once */
+    u_char slot = c->order[i];
+    const Layer *l = t->layer[slot];
+    Vec2 center;
+    Region r;
+    pvec2Unpack(&center, l->pos);
+    abShapeGetBounds(l->desc->abShape, &center, &r);
+    regionPack(&bounds[slot], &r);
+  }
+  for (i = 1; i < c->count; i++) {	/* insertion sort by left edge */
+    u_char slot = c->order[i];
+    u_char left = bounds[slot].topLeft & 0xff;
+    for (j = i; j > 0 && (bounds[c->order[j - 1]].topLeft & 0xff) > left; j--)
+      c->order[j] = c->order[j - 1];
+    c->order[j] = slot;
+  }
+
+  for (i = 0; i < c->count; i++) {	/* sweep */
+    u_char a = c->order[i];
+    u_char rightA = bounds[a].botRight & 0xff;
+    for (j = i + 1; j < c->count; j++) {
+      u_char b = c->order[j];
+      PRegion overlap;
+      Region area;
+      Vec2 centerA, centerB;
+      if ((bounds[b].topLeft & 0xff) > rightA)
+	break;			/* b and all after it start right of a */
+      overlap.topLeft = pvec2Max(bounds[a].topLeft, bounds[b].topLeft);
+      overlap.botRight = pvec2Min(bounds[a].botRight, bounds[b].botRight);
+      if ((overlap.topLeft >> 8) > (overlap.botRight >> 8))
+	continue;		/* rows don't overlap */
+      regionUnpack(&area, &overlap);
+      pvec2Unpack(&centerA, t->layer[a]->pos);
+      pvec2Unpack(&centerB, t->layer[b]->pos);
+      if (collideShapes(t->layer[a]->desc->abShape, &centerA,
+			t->layer[b]->desc->abShape, &centerB, &area)) {
+	contact(a, b);
+	contacts++;
+      }
+    }
+  }
+  return contacts;
+}
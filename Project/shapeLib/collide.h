@@ -0,0 +1,44 @@
+/** \file collide.h
+ *  \brief Collision detection between the layers of a LayerTable.
+ *
+ *  Broad phase: each candidate layer's bounds are computed once, and
+ *  the layers are sorted by their left edges and swept from left to
+ *  right (sort and sweep), so only layers whose columns overlap are
+ *  compared.  The sort order is kept from frame to frame; layers move
+ *  little between frames, so the insertion sort is nearly linear.
+ *
+ *  Narrow phase: for pairs whose bounds overlap, each row of the
+ *  overlap is tested a word at a time by intersecting the two shapes'
+ *  coverage words (see AbShape), so contacts are pixel exact.
+ *
+ *  Layers collide at their current positions (pos), i.e. as drawn.
+ */
+#ifndef collide_included
+#define collide_included
+
+#include "layerTable.h"
+
+/** Called once per frame for each pair of slots whose shapes touch */
+typedef void (*CollideContact)(u_char slotA, u_char slotB);
+
+typedef struct {
+  u_char order[LAYER_TABLE_SIZE];	/* candidate slots by left edge */
+  u_char count;				/* entries of order[] */
+} Collider;
+
+/** No candidates yet */
+void collideInit(Collider *c);
+
+/** Report (to contact) every pair of layers in slots mask whose
+ *  shapes share a pixel.
+ *  \return the number of pairs reported
+ */
+u_char collideLayers(Collider *c, const LayerTable *t, u_int mask, CollideContact contact);
+
+/** True if shapes a (centered at centerA) and b (at centerB) share a
+ *  pixel within area, which should be the overlap of their bounds.
+ */
+int collideShapes(const AbShape *a, const Vec2 *centerA,
+		  const AbShape *b, const Vec2 *centerB, const Region *area);
+
+#endif // collide_included
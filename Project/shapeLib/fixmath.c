@@ -0,0 +1,145 @@
+#include "fixmath.h"
+
+/** sin of 0 to a quarter turn in Q8.8: 256 sin(i pi / 128) */
+static const int fixSines[65] = {
+  0, 6, 13, 19, 25, 31, 38, 44, 50, 56, 62, 68, 74,
+  80, 86, 92, 98, 104, 109, 115, 121, 126, 132, 137, 142, 147,
+  152, 157, 162, 167, 172, 177, 181, 185, 190, 194, 198, 202, 206,
+  209, 213, 216, 220, 223, 226, 229, 231, 234, 237, 239, 241, 243,
+  245, 247, 248, 250, 251, 252, 253, 254, 255, 255, 256, 256, 256,
+};
+
+/** Octant angles: atan((i + 1/2) / 64) in 256ths of a turn */
+static const u_char fixAtans[64] = {
+  0, 1, 2, 2, 3, 3, 4, 5, 5, 6, 7, 7, 8, 8, 9, 10,
+  10, 11, 11, 12, 13, 13, 14, 14, 15, 15, 16, 17, 17, 18, 18, 19,
+  19, 20, 20, 21, 21, 22, 22, 23, 23, 23, 24, 24, 25, 25, 26, 26,
+  26, 27, 27, 28, 28, 28, 29, 29, 29, 30, 30, 31, 31, 31, 32, 32,
+};
+
+int
+fixSin(u_char angle)
+{
+  u_char i = angle & 63;
+  int s;
+  if (angle & 64)		/* second or fourth quarter: mirrored */
+    i = 64 - i;
+  s = fixSines[i];
+  return (angle & 128) ? -s : s;
+}
+
+int
+fixMulQ8(int v, int q)
+{
+  u_char neg = 0, i;
+  u_int p = 0;
+  if (v < 0) {
+    v = -v;
+    neg = 1;
+  }
+  if (q < 0) {
+    q = -q;
+    neg ^= 1;
+  }
+  for (i = 0; i < 8; i++) {	/* a bit of q at a time, lowest first */
+    if (q & 1)
+      p += v;
+    p >>= 1;
+    q >>= 1;
+  }
+  if (q)			/* q was FIX_ONE */
+    p += v;
+  return neg ? -(int)p : (int)p;
+}
+
+void
+fixPolar(Vec2 *v, u_char angle, int length)
+{
+  v->axes[0] = fixMulQ8(length, fixCos(angle));
+  v->axes[1] = fixMulQ8(length, fixSin(angle));
+}
+
+u_char
+fixAtan2(int y, int x)
+{
+  u_int ax = x < 0 ? -(u_int)x : (u_int)x, ay = y < 0 ? -(u_int)y : (u_int)y;
+  u_int t, q = 0;
+  u_char swap = 0, i, angle;
+  if (ay > ax) {		/* fold into the first octant: ay <= ax */
+    t = ax;
+    ax = ay;
+    ay = t;
+    swap = 1;
+  }
+  if (!ax)
+    return 0;
+  while (ax >= 512) {		/* so ay << 6 fits */
+    ax >>= 1;
+    ay >>= 1;
+  }
+  for (i = 0; i < 6; i++) {	/* q = 64 ay / ax, by shift and subtract */
+    ay <<= 1;
+    q <<= 1;
+    if (ay >= ax) {
+      ay -= ax;
+      q |= 1;
+    }
+  }
+  angle = fixAtans[q > 63 ? 63 : q];
+  if (swap)
+    angle = 64 - angle;
+  if (x < 0)
+    angle = 128 - angle;
+  if (y < 0)
+    angle = -angle;
+  return angle;
+}
+
+void
+fixNormalize(Vec2 *v, int length)
+{
+  fixPolar(v, fixAtan2(v->axes[1], v->axes[0]), length);
+}
+
+u_int
+fixSquare(int v)
+{
+  u_int a, sq = 0;
+  u_char b;
+  if (v < 0)
+    v = -v;
+  if (v > 255)
+    return FIX_FAR;
+  a = v;
+  for (b = v; b; b >>= 1) {	/* shift and add, one bit of v at a time */
+    if (b & 1)
+      sq += a;
+    a <<= 1;
+  }
+  return sq;
+}
+
+u_int
+fixDistSq(const Vec2 *a, const Vec2 *b)
+{
+  u_int dc = fixSquare(a->axes[0] - b->axes[0]);
+  u_int dr = fixSquare(a->axes[1] - b->axes[1]);
+  return (dr >= FIX_FAR - dc) ? FIX_FAR : dc + dr; /* or either was */
+}
+
+u_char
+fixSqrt(u_int n)
+{
+  u_int root = 0, bit = 1u << 14;
+  while (bit > n)		/* highest power of 4 <= n */
+    bit >>= 2;
+  while (bit) {			/* a bit of the root at a time */
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else
+      root >>= 1;
+    bit >>= 2;
+  }
+  return root;
+}
@@ -0,0 +1,70 @@
+/** \file fixmath.h
+ *  \brief Fixed-point trigonometry, square roots and distances for 16-bit ints.
+ *
+ *  The MSP430G2553 has no hardware multiplier or divider, so a C
+ *  multiply or divide is a libgcc loop.  These routines use table
+ *  lookups and short shift-add loops on 16-bit values instead.
+ *
+ *  Angles are u_chars in 256ths of a turn (64 is a right angle), so
+ *  they wrap for free.  Angle 0 points right (+col) and 64 points
+ *  down (+row), as on the screen.  Sines and cosines are Q8.8 (256 is
+ *  1), which makes fixPolar's vectors ready to use as LayerTable
+ *  velocities.
+ *
+ *  The work each routine does is below; mathbench displays each one's
+ *  cost in MCLK cycles per call, beside that of plain C multiply and
+ *  divide where there is an equivalent:
+ *   - fixSin, fixCos: a table lookup plus folding into a quarter turn.
+ *   - fixMulQ8: 8 add-and-shift steps (fixPolar: two of them).
+ *   - fixAtan2: folding into an octant, a 6 step shift-subtract
+ *     divide and a table lookup.
+ *   - fixSquare: an add-and-shift step per bit of the operand (8 at most);
+ *     fixDistSq is two of them.
+ *   - fixSqrt: 8 shift-compare-subtract steps.
+ */
+#ifndef fixmath_included
+#define fixmath_included
+
+#include "shape.h"
+
+#define FIX_ONE 256		/* 1 in Q8.8 */
+#define FIX_FAR 0xffff		/* fixDistSq of points too far apart to say */
+
+/** sin(angle) in Q8.8 */
+int fixSin(u_char angle);
+
+/** cos(angle) in Q8.8 */
+#define fixCos(angle) fixSin((u_char)((angle) + 64))
+
+/** v * q / 256, rounded toward zero, for |q| <= FIX_ONE */
+int fixMulQ8(int v, int q);
+
+/** Set v to the vector of the given length pointing at angle */
+void fixPolar(Vec2 *v, u_char angle, int length);
+
+/** Angle of the vector (x, y), to within a 256th of a turn; 0 for (0, 0) */
+u_char fixAtan2(int y, int x);
+
+/** Scale v to the given length, keeping its direction */
+void fixNormalize(Vec2 *v, int length);
+
+/** v * v, or FIX_FAR if |v| > 255 */
+u_int fixSquare(int v);
+
+/** Squared distance between a and b, or FIX_FAR if it doesn't fit
+ *  (anything on the screen fits)
+ */
+u_int fixDistSq(const Vec2 *a, const Vec2 *b);
+
+/** Square root of n, rounded down */
+u_char fixSqrt(u_int n);
+
+/** Distance between a and b, rounded down */
+#define fixDist(a, b) fixSqrt(fixDistSq(a, b))
+
+/** Are a and b within r of each other (e.g. two circles' centers
+ *  within the sum of their radii)?  No square root needed.
+ */
+#define fixWithin(a, b, r) (fixDistSq(a, b) <= fixSquare(r))
+
+#endif // fixmath_included
@@ -0,0 +1,114 @@
+#include "grid.h"
+
+/** Column or row of cells containing coordinate pos, clamped to the grid */
+static u_char
+gridCell(int pos, u_char cells)
+{
+  if (pos < 0)
+    return 0;
+  pos >>= GRID_CELL_SHIFT;
+  return pos < cells ? pos : cells - 1;
+}
+
+/** Objects in any column (or row) of masks lo..hi */
+static GridMask
+gridBands(const GridMask *masks, u_char lo, u_char hi)
+{
+  GridMask objects = 0;
+  for (; lo <= hi; lo++)
+    objects |= masks[lo];
+  return objects;
+}
+
+/** Objects in any of the count columns (or rows) of masks holding bit */
+static GridMask
+gridBandsOf(const GridMask *masks, u_char count, GridMask bit)
+{
+  GridMask objects = 0;
+  u_char i;
+  for (i = 0; i < count; i++)
+    if (masks[i] & bit)
+      objects |= masks[i];
+  return objects;
+}
+
+/** Set bit in masks lo..hi and clear it in the rest of the count */
+static void
+gridMark(GridMask *masks, u_char count, u_char lo, u_char hi, GridMask bit)
+{
+  u_char i;
+  for (i = 0; i < count; i++)
+    masks[i] = (i >= lo && i <= hi) ? masks[i] | bit : masks[i] & ~bit;
+}
+
+void
+gridInit(Grid *g)
+{
+  u_char i;
+  for (i = 0; i < GRID_COLS; i++)
+    g->cols[i] = 0;
+  for (i = 0; i < GRID_ROWS; i++)
+    g->rows[i] = 0;
+}
+
+void
+gridPlace(Grid *g, u_char id, const Region *bounds)
+{
+  GridMask bit = gridBit(id);
+  gridMark(g->cols, GRID_COLS, gridCell(bounds->topLeft.axes[0], GRID_COLS),
+	   gridCell(bounds->botRight.axes[0], GRID_COLS), bit);
+  gridMark(g->rows, GRID_ROWS, gridCell(bounds->topLeft.axes[1], GRID_ROWS),
+	   gridCell(bounds->botRight.axes[1], GRID_ROWS), bit);
+}
+
+void
+gridRemove(Grid *g, u_char id)
+{
+  GridMask bit = gridBit(id);
+  u_char i;
+  for (i = 0; i < GRID_COLS; i++)
+    g->cols[i] &= ~bit;
+  for (i = 0; i < GRID_ROWS; i++)
+    g->rows[i] &= ~bit;
+}
+
+GridMask
+gridQueryPoint(const Grid *g, int col, int row)
+{
+  if (col < 0 || col >= screenWidth || row < 0 || row >= screenHeight)
+    return 0;
+  return g->cols[col >> GRID_CELL_SHIFT] & g->rows[row >> GRID_CELL_SHIFT];
+}
+
+GridMask
+gridQueryRegion(const Grid *g, const Region *area)
+{
+  return (gridBands(g->cols, gridCell(area->topLeft.axes[0], GRID_COLS),
+		    gridCell(area->botRight.axes[0], GRID_COLS)) &
+	  gridBands(g->rows, gridCell(area->topLeft.axes[1], GRID_ROWS),
+		    gridCell(area->botRight.axes[1], GRID_ROWS)));
+}
+
+GridMask
+gridNeighbors(const Grid *g, u_char id)
+{
+  GridMask bit = gridBit(id);
+  return (gridBandsOf(g->cols, GRID_COLS, bit) &
+	  gridBandsOf(g->rows, GRID_ROWS, bit) & ~bit);
+}
+
+u_int
+gridPairs(const Grid *g, GridPairFn pair)
+{
+  u_char a, b;
+  u_int pairs = 0;
+  for (a = 0; a < GRID_OBJECTS; a++) {
+    GridMask later = gridNeighbors(g, a) >> a >> 1; /* only b > a */
+    for (b = a + 1; later; b++, later >>= 1)
+      if (later & 1) {
+	pair(a, b);
+	pairs++;
+      }
+  }
+  return pairs;
+}
@@ -0,0 +1,64 @@
+/** \file grid.h
+ *  \brief Uniform grid of 32x32 pixel cells for collision and hit queries.
+ *
+ *  Objects (numbered 0 to GRID_OBJECTS-1, e.g. by the caller's layer
+ *  table slot or bullet index) are placed by their bounds and occupy every cell the
+ *  bounds touch.  Rather than a list per cell, the grid keeps one bit
+ *  mask of objects per column of cells and one per row of cells.  An
+ *  object's cells are a rectangle of columns x rows, so the objects in
+ *  a cell are exactly those in both its column's and its row's masks,
+ *  and the whole grid takes (GRID_COLS + GRID_ROWS) masks: 36 bytes
+ *  for 32 objects.  The masks also say which cells each object is in,
+ *  so nothing is kept per object.
+ *
+ *  Placing an object rewrites every column's and row's mask, whatever
+ *  cells it was in before.
+ */
+#ifndef grid_included
+#define grid_included
+
+#include "shape.h"
+
+#define GRID_CELL_SHIFT 5	/* 32x32 pixel cells */
+#define GRID_COLS ((screenWidth + 31) >> GRID_CELL_SHIFT)
+#define GRID_ROWS ((screenHeight + 31) >> GRID_CELL_SHIFT)
+#define GRID_OBJECTS 32		/* bits in a GridMask */
+
+typedef unsigned long GridMask;	/* one bit per object */
+
+#define gridBit(id) (1ul << (id))
+
+typedef struct {
+  GridMask cols[GRID_COLS];	/* objects in each column of cells */
+  GridMask rows[GRID_ROWS];	/* objects in each row of cells */
+} Grid;
+
+/** Called for each pair of objects sharing a cell (a < b) */
+typedef void (*GridPairFn)(u_char a, u_char b);
+
+/** Empty the grid */
+void gridInit(Grid *g);
+
+/** Place object id by its bounds (clipped to the screen), or move it
+ *  if already placed.
+ */
+void gridPlace(Grid *g, u_char id, const Region *bounds);
+
+/** Take object id out of the grid */
+void gridRemove(Grid *g, u_char id);
+
+/** Objects in the cell containing pixel (col, row) */
+GridMask gridQueryPoint(const Grid *g, int col, int row);
+
+/** Objects in any cell touched by area */
+GridMask gridQueryRegion(const Grid *g, const Region *area);
+
+/** Objects sharing a cell with object id (not including id) */
+GridMask gridNeighbors(const Grid *g, u_char id);
+
+/** Report each pair of objects sharing a cell to pair, once.
+ *  \return the number of pairs
+ */
+u_int gridPairs(const Grid *g, GridPairFn pair);
+
+#endif // grid_included
@@ -0,0 +1,135 @@
+/** \file gridbench.c
+ *  \brief Measures the spatial grid with GRID_OBJECTS moving objects.
+ *
+ *  Each frame moves every object a pixel or two, updates the grid
+ *  and finds the pairs whose cells are shared; all-pairs bounds tests
+ *  are timed for comparison.  Costs are displayed in MCLK cycles per
+ *  frame, averaged over BENCH_FRAMES; a 25 Hz frame is 640000 cycles.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "grid.h"
+
+#define BENCH_FRAMES 50
+#define OBJECT_HALF 4		/* objects' bounds are 9x9 */
+
+u_int bgColor = COLOR_BLACK;
+
+Grid grid;
+Vec2 centers[GRID_OBJECTS];
+signed char velocities[GRID_OBJECTS][2];
+u_int pairCount;
+
+static void
+countPair(u_char a, u_char b)
+{
+  pairCount++;
+}
+
+/** Bounds of object id */
+static void
+objectBounds(u_char id, Region *bounds)
+{
+  static const Vec2 half = {OBJECT_HALF, OBJECT_HALF};
+  vec2Sub(&bounds->topLeft, &centers[id], &half);
+  vec2Add(&bounds->botRight, &centers[id], &half);
+}
+
+/** Move every object, bouncing off the screen's edges */
+static void
+moveObjects()
+{
+  u_char id, axis;
+  for (id = 0; id < GRID_OBJECTS; id++)
+    for (axis = 0; axis < 2; axis++) {
+      int pos = centers[id].axes[axis] + velocities[id][axis];
+      int limit = (axis ? screenHeight : screenWidth) - 1 - OBJECT_HALF;
+      if (pos < OBJECT_HALF || pos > limit)
+	velocities[id][axis] = -velocities[id][axis];
+      else
+	centers[id].axes[axis] = pos;
+    }
+}
+
+static void
+report(u_char row, char *name, unsigned long ticks)
+{
+  char num[8];
+  drawString5x7(2, row, name, COLOR_WHITE, bgColor);
+  formatNum(num, ticks * STOPWATCH_CYCLES_PER_TICK / BENCH_FRAMES, 7);
+  drawString5x7(70, row, num, COLOR_GREEN, bgColor);
+}
+
+int
+main()
+{
+  unsigned long moveTicks, updateTicks, pairTicks, bruteTicks;
+  u_char id, frame;
+  u_int brutePairs = 0;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/* GIE on: stopwatch needs its overflow interrupt */
+  clearScreen(bgColor);
+  drawString5x7(2, 5, "grid, cycles/frame", COLOR_WHITE, bgColor);
+
+  gridInit(&grid);
+  for (id = 0; id < GRID_OBJECTS; id++) {
+    centers[id].axes[0] = OBJECT_HALF + (id * 37) % (screenWidth - 2 * OBJECT_HALF);
+    centers[id].axes[1] = OBJECT_HALF + (id * 53) % (screenHeight - 2 * OBJECT_HALF);
+    velocities[id][0] = (id & 1) ? 1 : -2;
+    velocities[id][1] = (id & 2) ? 2 : -1;
+  }
+
+  moveTicks = updateTicks = pairTicks = bruteTicks = 0;
+  pairCount = 0;
+  for (frame = 0; frame < BENCH_FRAMES; frame++) {
+    stopwatchStart();
+    moveObjects();
+    moveTicks += stopwatchRead();
+
+    stopwatchStart();
+    for (id = 0; id < GRID_OBJECTS; id++) {
+      Region bounds;
+      objectBounds(id, &bounds);
+      gridPlace(&grid, id, &bounds);
+    }
+    updateTicks += stopwatchRead();
+
+    stopwatchStart();
+    gridPairs(&grid, countPair);
+    pairTicks += stopwatchRead();
+
+    stopwatchStart();
+    {				/* all pairs, for comparison */
+      u_char a, b;
+      for (a = 0; a < GRID_OBJECTS; a++)
+	for (b = a + 1; b < GRID_OBJECTS; b++) {
+	  int dCol = centers[a].axes[0] - centers[b].axes[0];
+	  int dRow = centers[a].axes[1] - centers[b].axes[1];
+	  if (dCol <= 2 * OBJECT_HALF && dCol >= -2 * OBJECT_HALF &&
+	      dRow <= 2 * OBJECT_HALF && dRow >= -2 * OBJECT_HALF)
+	    brutePairs++;
+	}
+    }
+    bruteTicks += stopwatchRead();
+  }
+
+  report(25, "move (base)", moveTicks);
+  report(35, "grid update", updateTicks);
+  report(45, "grid pairs", pairTicks);
+  report(55, "all pairs", bruteTicks);
+  {
+    char num[8];
+    drawString5x7(2, 75, "cell pairs", COLOR_WHITE, bgColor);
+    formatNum(num, pairCount / BENCH_FRAMES, 7);
+    drawString5x7(70, 75, num, COLOR_YELLOW, bgColor);
+    drawString5x7(2, 85, "touching", COLOR_WHITE, bgColor);
+    formatNum(num, brutePairs / BENCH_FRAMES, 7);
+    drawString5x7(70, 85, num, COLOR_YELLOW, bgColor);
+  }
+
+  or_sr(0x10);			/* CPU off */
+}
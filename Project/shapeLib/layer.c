@@ -3,34 +3,118 @@
 #include "shape.h"
 
 void
-layerDraw(Layer *layers)
+layerComposite(const Layer *const *probes, u_char count, const Region *area)
 {
-  int row, col;
-  for (row = 0; row < screenHeight; row++) {
-    lcd_setArea(0, row, screenWidth-1, row);
-    for (col = 0; col < screenWidth; col++) {
-      Vec2 pixelPos = {col, row};
-      u_int color = bgColor;
-      Layer *probeLayer;
-      for (probeLayer = layers; probeLayer; probeLayer = probeLayer->next) {
-	if (abShapeCheck(probeLayer->abShape, &probeLayer->pos, &pixelPos)) {
-	  color = probeLayer->color;
-	  break; 
-	} /* if check */
-      } // for checking all layers at col, row
-      lcd_writeColor(color); 
-    } // for col
+  u_int hitMask[LAYER_PROBE_MAX];	/* pixels of this word each hit layer colors */
+  u_int hitColor[LAYER_PROBE_MAX];
+  int row, col, right = area->botRight.axes[0];
+  if (regionIsEmpty(area))	/* e.g. bounds wholly off screen, clipped */
+    return;
+  lcd_setArea(area->topLeft.axes[0], area->topLeft.axes[1],
+	      area->botRight.axes[0], area->botRight.axes[1]);
+  for (row = area->topLeft.axes[1]; row <= area->botRight.axes[1]; row++) {
+    for (col = area->topLeft.axes[0]; col <= right; col += 16) {
+      u_int word = coverageSpan(col, col, right); /* pixels of area in this word */
+      u_int open = word, bit;	/* pixels not yet claimed by a layer */
+      u_char i, hits = 0;
+      for (i = 0; i < count && open; i++) { /* front to back */
+	const Layer *probeLayer = probes[i];
+	Vec2 center;
+	u_int mask;
+	pvec2Unpack(&center, probeLayer->pos);
+	mask = abShapeCoverage(probeLayer->desc->abShape, &center, col, row) & open;
+	if (mask) {
+	  hitMask[hits] = mask;
+	  hitColor[hits++] = probeLayer->desc->color;
+	  open &= ~mask;
+	}
+      } // for probing layers
+      for (bit = 1; bit & word; ) { /* write runs of one color */
+	u_int color = bgColor, run = open;
+	for (i = 0; i < hits; i++) {
+	  if (hitMask[i] & bit) {
+	    color = hitColor[i];
+	    run = hitMask[i];
+	    break;
+	  }
+	}
+	do {
+	  lcd_writeColor(color);
+	  bit <<= 1;
+	} while (bit & run);
+      } // for runs
+    } // for word
   } // for row
-} 
+}
 
+void
+layerDraw(Layer *layers)
+{
+  static const Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}};
+  const Layer *probes[LAYER_PROBE_MAX];
+  u_char count = 0;
+  for (; layers && count < LAYER_PROBE_MAX; layers = layers->next)
+    probes[count++] = layers;
+  layerComposite(probes, count, &screen);
+}
 
 
+void
+layerPaintLayers(const Layer *const *probes, u_char count)
+{
+  clearScreen(bgColor);
+  while (count--) {		/* back to front, so front layers paint last */
+    const Layer *l = probes[count];
+    const AbShape *shape = l->desc->abShape;
+    u_int color = l->desc->color;
+    Region bounds;
+    Vec2 center;
+    int row, col, left, right;
+    pvec2Unpack(&center, l->pos);
+    abShapeGetBounds(shape, &center, &bounds);
+    regionClipScreen(&bounds);
+    if (regionIsEmpty(&bounds))
+      continue;			/* wholly off screen */
+    left = bounds.topLeft.axes[0];
+    right = bounds.botRight.axes[0];
+    for (row = bounds.topLeft.axes[1]; row <= bounds.botRight.axes[1]; row++) {
+      for (col = left; col <= right; col += 16) {
+	u_int mask = abShapeCoverage(shape, &center, col, row) & coverageSpan(col, col, right);
+	int runCol = col;
+	while (mask) {		/* paint each run of covered pixels */
+	  int runEnd;
+	  for (; !(mask & 1); mask >>= 1)
+	    runCol++;
+	  for (runEnd = runCol; mask & 1; mask >>= 1)
+	    runEnd++;
+	  lcd_setArea(runCol, row, runEnd - 1, row);
+	  for (; runCol < runEnd; runCol++)
+	    lcd_writeColor(color);
+	}
+      } // for word
+    } // for row
+  } // for layer
+}
+
+void
+layerPaint(Layer *layers)
+{
+  const Layer *probes[LAYER_PROBE_MAX];
+  u_char count = 0;
+  for (; layers && count < LAYER_PROBE_MAX; layers = layers->next)
+    probes[count++] = layers;
+  layerPaintLayers(probes, count);
+}
+
 void
 layerGetBounds(const Layer *l, Region *bounds)
 {
   Region lastBounds, curBounds;
-  abShapeGetBounds(l->abShape, &l->posLast, &lastBounds);
-  abShapeGetBounds(l->abShape, &l->pos, &curBounds);
+  Vec2 pos, posLast;
+  pvec2Unpack(&posLast, l->posLast);
+  pvec2Unpack(&pos, l->pos);
+  abShapeGetBounds(l->desc->abShape, &posLast, &lastBounds);
+  abShapeGetBounds(l->desc->abShape, &pos, &curBounds);
   regionUnion(bounds, &curBounds, &lastBounds);
   regionClipScreen(bounds);
 }
@@ -42,3 +126,11 @@ layerInit(Layer *layer)
     layer->posLast = layer->posNext = layer->pos;
 }
 
+u_int
+layerRamSavedEstimate(const Layer *layer, u_int constShapeBytes)
+{
+  u_int saved = constShapeBytes;
+  for (; layer; layer = layer->next)
+    saved += LAYER_RAM_UNPACKED - sizeof(Layer);
+  return saved;
+}
@@ -0,0 +1,375 @@
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "layerTable.h"
+
+void
+layerTableInit(LayerTable *t)
+{
+  t->orderLen = 0;
+  t->front = 0;
+  t->reading = LAYER_NONE;
+  t->used = t->visible = t->moving = t->solid = t->dirty = t->moved = 0;
+}
+
+/** Squeeze the holes left by removed layers out of order[] */
+static void
+layerTableCompact(LayerTable *t)
+{
+  u_char from, to = 0;
+  for (from = 0; from < t->orderLen; from++) {
+    u_char slot = t->order[from];
+    if (slot != LAYER_NONE) {
+      t->order[to] = slot;
+      t->zIndex[slot] = to++;
+    }
+  }
+  t->orderLen = to;
+}
+
+u_char
+layerTableInsert(LayerTable *t, Layer *layer)
+{
+  u_char slot;
+  u_int bit;
+  for (slot = 0, bit = 1; t->used & bit; slot++, bit <<= 1)
+    if (slot == LAYER_TABLE_SIZE - 1)
+      return LAYER_NONE;	/* full */
+  if (t->orderLen == LAYER_TABLE_SIZE)
+    layerTableCompact(t);	/* fewer than LAYER_TABLE_SIZE used, so room after */
+  t->layer[slot] = layer;
+  t->velocity[slot].axes[0] = t->velocity[slot].axes[1] = 0;
+  t->frac[slot][0] = t->frac[slot][1] = 0;
+  t->fence[slot] = LAYER_FENCE_BOUNCE;
+  t->zIndex[slot] = t->orderLen;
+  t->order[t->orderLen++] = slot;
+  t->used |= bit;
+  t->visible |= bit;
+  layer->posLast = layer->posNext = layer->pos;
+  t->next[0][slot] = t->next[1][slot] = layer->pos; /* as if advanced */
+  return slot;
+}
+
+void
+layerTableRemove(LayerTable *t, u_char slot)
+{
+  u_int bit = layerTableBit(slot);
+  if (!(t->used & bit))		/* not in use: its zIndex may be stale */
+    return;
+  t->order[t->zIndex[slot]] = LAYER_NONE;
+  while (t->orderLen && t->order[t->orderLen - 1] == LAYER_NONE)
+    t->orderLen--;		/* drop holes at the back */
+  t->used &= ~bit;
+  t->visible &= ~bit;
+  t->moving &= ~bit;
+  t->solid &= ~bit;
+  t->moved &= ~bit;
+}
+
+/** Swap slot with the nearest layer step entries away in order[] */
+static void
+layerTableSwap(LayerTable *t, u_char slot, signed char step)
+{
+  u_char from = t->zIndex[slot], to = from;
+  u_char other;
+  do {
+    to += step;
+    if (to >= t->orderLen)	/* ran off either end (u_char wraps below 0) */
+      return;
+  } while ((other = t->order[to]) == LAYER_NONE);
+  t->order[to] = slot;
+  t->zIndex[slot] = to;
+  t->order[from] = other;
+  t->zIndex[other] = from;
+}
+
+void
+layerTableRaise(LayerTable *t, u_char slot)
+{
+  layerTableSwap(t, slot, -1);
+}
+
+void
+layerTableLower(LayerTable *t, u_char slot)
+{
+  layerTableSwap(t, slot, 1);
+}
+
+void
+layerTableSetVelocity(LayerTable *t, u_char slot, int col, int row)
+{
+  t->velocity[slot].axes[0] = col;
+  t->velocity[slot].axes[1] = row;
+  t->moving |= layerTableBit(slot);
+}
+
+/** Where a step first meets something, for the bounce */
+typedef struct {
+  int face;			/* last free position on axis */
+  int push;			/* if overlapping already: the way out on axis; else 0 */
+  u_char axis;
+  u_char wall;			/* a wall of the fence (else a solid layer) */
+} LayerTableHit;
+
+/** Earliest point at which bounds, stepping by step, meets a wall of
+ *  fence (unless fence is 0) or the bounds of a solid layer other than
+ *  slot (where that layer is next).  Fills in hit; the leading edge of
+ *  bounds turns at hit->face.  If bounds already overlaps a solid
+ *  layer (one that moved onto it), that is a hit at time 0, and
+ *  hit->push is the shortest way out.
+ *  \return its time, as regionSweep, or REGION_SWEEP_MISS
+ */
+static u_int
+layerTableFirstHit(const LayerTable *t, u_char slot, const Region *fence,
+		   const Region *bounds, const Vec2 *step, LayerTableHit *hit)
+{
+  u_int solid = t->solid & ~layerTableBit(slot), first = REGION_SWEEP_MISS;
+  u_char a, other;
+  hit->push = 0;
+  for (a = 0; fence && a < 2; a++) {	/* the fence's walls */
+    int speed = step->axes[a], gap, wall;
+    if (speed > 0) {
+      wall = fence->botRight.axes[a];
+      gap = wall - bounds->botRight.axes[a];
+    } else if (speed < 0) {
+      speed = -speed;
+      wall = fence->topLeft.axes[a];
+      gap = bounds->topLeft.axes[a] - wall;
+    } else
+      continue;
+    if (gap < speed) {		/* would pass the wall */
+      u_int when = (gap < 0) ? 0 : ((long)gap << 8) / speed;
+      if (when < first) {
+	first = when;
+	hit->axis = a;
+	hit->face = wall;
+	hit->wall = 1;
+      }
+    }
+  }
+  for (other = 0; solid; other++, solid >>= 1) {
+    const Layer *o;
+    Vec2 center;
+    Region obstacle;
+    u_int when;
+    if (!(solid & 1))
+      continue;
+    o = t->layer[other];
+    pvec2Unpack(&center, o->posNext);
+    abShapeGetBounds(o->desc->abShape, &center, &obstacle);
+    when = regionSweep(bounds, step, &obstacle, &a);
+    if (when == REGION_SWEEP_OVERLAP) {	/* inside it now: out before anything else */
+      hit->axis = regionPushOut(bounds, &obstacle, &hit->push);
+      hit->wall = 0;
+      return 0;
+    }
+    if (when < first) {
+      first = when;
+      hit->axis = a;
+      hit->face = (step->axes[a] > 0) ?
+	obstacle.topLeft.axes[a] - 1 : obstacle.botRight.axes[a] + 1;
+      hit->wall = 0;
+    }
+  }
+  return first;
+}
+
+/** Turn the layer in slot, and the rest of its step, back on axis.
+ *  Its fraction of a pixel is mirrored too, so it is as far from its
+ *  next pixel going back as it was going on.
+ */
+static void
+layerTableReflect(LayerTable *t, u_char slot, Vec2 *step, u_char axis)
+{
+  step->axes[axis] = -step->axes[axis];
+  t->velocity[slot].axes[axis] = -t->velocity[slot].axes[axis];
+  t->frac[slot][axis] = -t->frac[slot][axis];
+}
+
+/** Move the layer in slot one step, meeting the fence as its policy says */
+static void
+layerTableStep(LayerTable *t, u_char slot, const Region *fence)
+{
+  Layer *l = t->layer[slot];
+  Vec2 *velocity = &t->velocity[slot];
+  Vec2 center, step;
+  Region bounds;
+  u_char policy = t->fence[slot], axis, bounces;
+  for (axis = 0; axis < 2; axis++) { /* whole pixels moved; keep the fraction */
+    int sum = t->frac[slot][axis] + velocity->axes[axis];
+    step.axes[axis] = sum >> 8;
+    t->frac[slot][axis] = sum;
+  }
+  if (!(step.axes[0] | step.axes[1]) && !(t->solid & ~layerTableBit(slot)))
+    return;			/* still on the same pixel, and nothing to be pushed out of */
+  pvec2Unpack(&center, l->posNext);
+  abShapeGetBounds(l->desc->abShape, &center, &bounds);
+  for (bounces = 0; bounces < LAYER_TABLE_BOUNCES; bounces++) {
+    LayerTableHit hit;
+    Vec2 travel;		/* to the point of contact */
+    int across, part;
+    u_int when = layerTableFirstHit(t, slot, (policy == LAYER_FENCE_WRAP) ? 0 : fence,
+				    &bounds, &step, &hit);
+    if (when == REGION_SWEEP_MISS)
+      break;
+    axis = hit.axis;
+    if (hit.push) {		/* out of a solid layer, then away from it */
+      center.axes[axis] += hit.push;
+      bounds.topLeft.axes[axis] += hit.push;
+      bounds.botRight.axes[axis] += hit.push;
+      if ((hit.push > 0) != (step.axes[axis] > 0) && step.axes[axis])
+	layerTableReflect(t, slot, &step, axis);
+      continue;
+    }
+    travel.axes[axis] = hit.face - ((step.axes[axis] > 0) ?
+				    bounds.botRight.axes[axis] : bounds.topLeft.axes[axis]);
+    across = step.axes[!axis];	/* rounded toward 0, so as not to meet anything else */
+    part = (int)(((long)(across < 0 ? -across : across) * when) >> 8);
+    travel.axes[!axis] = across < 0 ? -part : part;
+    vec2Add(&center, &center, &travel);
+    vec2Add(&bounds.topLeft, &bounds.topLeft, &travel);
+    vec2Add(&bounds.botRight, &bounds.botRight, &travel);
+    vec2Sub(&step, &step, &travel);
+    if (hit.wall && policy == LAYER_FENCE_STOP) {
+      velocity->axes[0] = velocity->axes[1] = 0;
+      step.axes[0] = step.axes[1] = 0;
+      break;
+    }
+    if (hit.wall && policy == LAYER_FENCE_CLAMP) {
+      step.axes[axis] = 0;	/* held at the wall; slides on along it */
+      continue;
+    }
+    layerTableReflect(t, slot, &step, axis); /* the rest of the step, reflected */
+  }
+  if (bounces < LAYER_TABLE_BOUNCES)	/* else stop where it last bounced */
+    vec2Add(&center, &center, &step);
+  if (policy == LAYER_FENCE_WRAP) {
+    for (axis = 0; axis < 2; axis++) {	/* by its center */
+      int lo = fence->topLeft.axes[axis], hi = fence->botRight.axes[axis];
+      if (center.axes[axis] > hi)
+	center.axes[axis] -= hi - lo + 1;
+      else if (center.axes[axis] < lo)
+	center.axes[axis] += hi - lo + 1;
+    }
+  }
+  pvec2Pack(&l->posNext, &center);
+}
+
+void
+layerTableAdvance(LayerTable *t, const Region *fence)
+{
+  u_char slot, back = t->reading;	/* the set commit is copying, if any */
+  u_int moving, dirty = 0;
+  back = ((back == LAYER_NONE) ? t->front : back) ^ 1;
+  for (slot = 0, moving = t->moving; moving; slot++, moving >>= 1) {
+    if (moving & 1) {
+      Layer *l = t->layer[slot];
+      const Vec2 *velocity = &t->velocity[slot];
+      if (velocity->axes[0] | velocity->axes[1])	/* else not moving now */
+	layerTableStep(t, slot, fence);
+      if (l->posNext != l->pos)
+	dirty |= layerTableBit(slot);
+      t->next[back][slot] = l->posNext;
+    }
+  }
+  t->dirty = dirty;
+  t->front = back;		/* published */
+}
+
+u_int
+layerTableCommit(LayerTable *t)
+{
+  u_char slot, set = t->front;
+  u_int moving;
+  t->reading = set;		/* advances meanwhile write the other set */
+  for (slot = 0, moving = t->moving; moving; slot++, moving >>= 1) {
+    if (moving & 1) {		/* not just the dirty: an advance may have run since */
+      Layer *l = t->layer[slot];
+      PVec2 next = t->next[set][slot];
+      if (next == l->pos)
+	continue;		/* committed already */
+      if (!(t->moved & layerTableBit(slot)))
+	l->posLast = l->pos;	/* else still where it was last drawn */
+      l->pos = next;
+      t->moved |= layerTableBit(slot);
+    }
+  }
+  t->reading = LAYER_NONE;
+  return t->moved;
+}
+
+/** Collect the visible layers, front to back.  \return their count */
+static u_char
+layerTableProbes(const LayerTable *t, const Layer **probes)
+{
+  u_char probeCount = 0, i;
+  for (i = 0; i < t->orderLen; i++) {
+    u_char slot = t->order[i];
+    if (slot != LAYER_NONE && (t->visible & layerTableBit(slot)))
+      probes[probeCount++] = t->layer[slot];
+  }
+  return probeCount;
+}
+
+void
+layerTableDrawRegion(const LayerTable *t, const Region *area)
+{
+  const Layer *probes[LAYER_TABLE_SIZE];	/* visible layers, front to back */
+  layerComposite(probes, layerTableProbes(t, probes), area);
+}
+
+void
+layerTablePaint(const LayerTable *t)
+{
+  const Layer *probes[LAYER_TABLE_SIZE];
+  layerPaintLayers(probes, layerTableProbes(t, probes));
+}
+
+void
+layerTableDraw(const LayerTable *t)
+{
+  static const Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}};
+  layerTableDrawRegion(t, &screen);
+}
+
+/** Redraw where the layer in slot was last drawn and where it is now:
+ *  as one region if they meet, else (e.g. it wrapped) as two.
+ */
+static void
+layerTableDrawMoved(LayerTable *t, u_char slot)
+{
+  const Layer *l = t->layer[slot];
+  Region last, now;
+  Vec2 center;
+  pvec2Unpack(&center, l->posLast);
+  abShapeGetBounds(l->desc->abShape, &center, &last);
+  pvec2Unpack(&center, l->pos);
+  abShapeGetBounds(l->desc->abShape, &center, &now);
+  if (last.botRight.axes[0] < now.topLeft.axes[0] || now.botRight.axes[0] < last.topLeft.axes[0] ||
+      last.botRight.axes[1] < now.topLeft.axes[1] || now.botRight.axes[1] < last.topLeft.axes[1]) {
+    regionClipScreen(&last);
+    layerTableDrawRegion(t, &last);
+  } else
+    regionUnion(&now, &now, &last);
+  regionClipScreen(&now);
+  layerTableDrawRegion(t, &now);
+}
+
+void
+layerTableDrawMoving(LayerTable *t)
+{
+  u_char slot;
+  u_int moved;
+  for (slot = 0, moved = t->moved; moved; slot++, moved >>= 1) {
+    if (moved & 1)
+      layerTableDrawMoved(t, slot);
+  }
+  layerTableDrawn(t);
+}
+
+void
+layerTableUpdate(LayerTable *t, const Region *fence)
+{
+  layerTableAdvance(t, fence);
+  if (layerTableCommit(t))
+    layerTableDrawMoving(t);
+}
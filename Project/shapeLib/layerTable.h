@@ -0,0 +1,173 @@
+/** \file layerTable.h
+ *  \brief Fixed-capacity table of layers with z order, visibility and motion.
+ *
+ *  An alternative to linking Layers (and MovLayers) through their next
+ *  pointers.  Layers are referenced by slot number.  Their order,
+ *  visibility and motion are kept in small arrays and bit masks, so
+ *  reordering, hiding or removing a layer never relinks anything, and
+ *  the renderers and advance walk arrays rather than chasing pointers.
+ *
+ *  order[] lists slots front (top) to back.  Removing a layer leaves a
+ *  LAYER_NONE hole in order[]; holes are skipped when drawing and are
+ *  squeezed out when an insert finds order[] full.  So insert, remove,
+ *  show/hide and raise/lower one step are constant time (bounded by
+ *  LAYER_TABLE_SIZE).
+ *
+ *  A table takes 15 bytes a slot plus 16, 256 bytes at the default 16
+ *  slots.  A program needing fewer may define LAYER_TABLE_SIZE (e.g.
+ *  -DLAYER_TABLE_SIZE=8, 136 bytes); the library must be built with
+ *  the same value (make LAYER_TABLE_SIZE=8 install).  layerTableInit is
+ *  named after the size, so a program and library that disagree fail to
+ *  link rather than overrun each other's tables.
+ */
+#ifndef layerTable_included
+#define layerTable_included
+
+#include "shape.h"
+
+#ifndef LAYER_TABLE_SIZE
+#define LAYER_TABLE_SIZE 16	/* slots; at most 16 since masks are u_int */
+#endif
+#define LAYER_NONE 0xff		/* no slot */
+#define LAYER_TABLE_BOUNCES 4	/* most bounces followed in one step */
+
+/** Velocities are Q8.8 fixed point: pixels per advance, times 256.
+ *  LAYER_Q8(1.5) is a pixel and a half.
+ */
+#define LAYER_Q8(pixels) ((int)((pixels) * 256))
+
+/** What a moving layer does when it meets the fence (layerTableSetFence) */
+#define LAYER_FENCE_BOUNCE 0	/* reflects off it; the default */
+#define LAYER_FENCE_WRAP 1	/* leaves by one side, comes back by the other */
+#define LAYER_FENCE_CLAMP 2	/* is held at it, still sliding along it */
+#define LAYER_FENCE_STOP 3	/* stops where it meets it */
+
+typedef struct {
+  Layer *layer[LAYER_TABLE_SIZE];	/* by slot */
+  volatile PVec2 next[2][LAYER_TABLE_SIZE]; /* by set, then slot: next positions advanced */
+  Vec2 velocity[LAYER_TABLE_SIZE];	/* by slot, Q8.8 */
+  u_char frac[LAYER_TABLE_SIZE][2];	/* by slot: fraction of a pixel (Q0.8) of its position */
+  u_char fence[LAYER_TABLE_SIZE];	/* by slot: LAYER_FENCE_ policy */
+  u_char order[LAYER_TABLE_SIZE];	/* slots, front to back */
+  u_char zIndex[LAYER_TABLE_SIZE];	/* by slot: its index in order[] */
+  u_char orderLen;			/* entries of order[] in use, including holes */
+  volatile u_char front;		/* set of next[] last advanced */
+  volatile u_char reading;		/* set of next[] being committed, or LAYER_NONE */
+  u_int used, visible, moving, solid;	/* by slot, one bit each */
+  volatile u_int dirty;			/* moving, and next pixel position not current */
+  u_int moved;				/* made current since last drawn */
+} LayerTable;
+
+/** Bit for slot in the table's masks */
+#define layerTableBit(slot) (1u << (slot))
+
+/** Empty the table */
+#define layerTableInit layerTableSizedInit(LAYER_TABLE_SIZE)
+#define layerTableSizedInit(size) layerTableSizedInit_(size)
+#define layerTableSizedInit_(size) layerTableInit ## size
+void layerTableInit(LayerTable *t);
+
+/** Add a visible, stationary layer behind all others.
+ *
+ *  Like layerInit, sets the layer's last and next positions to pos.
+ *  \return The layer's slot, or LAYER_NONE if the table is full
+ */
+u_char layerTableInsert(LayerTable *t, Layer *layer);
+
+/** Remove the layer in slot.  Its slot may be reused by a later insert.
+ *  Removing a slot not in use (e.g. twice) does nothing.
+ */
+void layerTableRemove(LayerTable *t, u_char slot);
+
+/** Move the layer in slot one step toward the front (raise) or back (lower).
+ */
+void layerTableRaise(LayerTable *t, u_char slot);
+void layerTableLower(LayerTable *t, u_char slot);
+
+/** Show or hide the layer in slot.  Hidden layers are not drawn or probed.
+ */
+#define layerTableShow(t, slot) ((t)->visible |= layerTableBit(slot))
+#define layerTableHide(t, slot) ((t)->visible &= ~layerTableBit(slot))
+
+/** Set the velocity of the layer in slot, in Q8.8 pixels per advance
+ *  (see LAYER_Q8) up to 127 either way, and have layerTableAdvance
+ *  move it from now on.
+ */
+void layerTableSetVelocity(LayerTable *t, u_char slot, int col, int row);
+
+/** Set what the layer in slot does when it meets the fence, one of
+ *  the LAYER_FENCE_ policies.  Solid layers are bounced off whatever
+ *  the policy.
+ */
+#define layerTableSetFence(t, slot, policy) ((t)->fence[slot] = (policy))
+
+/** Make the layer in slot solid (or not): moving layers bounce off it.
+ */
+#define layerTableSetSolid(t, slot) ((t)->solid |= layerTableBit(slot))
+#define layerTableClearSolid(t, slot) ((t)->solid &= ~layerTableBit(slot))
+
+/** Advance every moving layer's next position by its velocity,
+ *  bouncing off the first solid layer in its way and meeting the walls
+ *  of fence as its policy says.  Layers whose velocity is zero are
+ *  skipped.
+ *
+ *  Each layer keeps the fraction of a pixel it has moved, so a layer
+ *  slower than a pixel per advance moves a pixel every few advances.
+ *  Only layers whose next pixel position differs from their current
+ *  one are marked dirty.
+ *
+ *  Bounces are found by sweeping the layer's bounds along its step
+ *  (regionSweep), so however large the step, a layer reflects where
+ *  it meets a wall or a solid layer's bounds and never passes through
+ *  it.  The rest of the step continues in the reflected direction;
+ *  after LAYER_TABLE_BOUNCES bounces in one step the layer stops.
+ *
+ *  Solid layers are taken where they are next, as if still during the
+ *  step.  One that moves (by its own velocity, or by a path) onto a
+ *  layer is not swept; instead the layer is pushed out of it the
+ *  shortest way at its next advance, and turned away from it.
+ */
+void layerTableAdvance(LayerTable *t, const Region *fence);
+
+/** Make each dirty layer's next position current (pos), remembering
+ *  where it was last drawn (posLast) so layerTableDrawMoving can erase
+ *  it.  So several advances may be committed (e.g. for collisions)
+ *  before a draw.
+ *
+ *  layerTableAdvance may run in an ISR.  Next positions are double
+ *  buffered: each advance writes its moving layers' next positions to
+ *  the set of next[] that commit isn't copying, then publishes it by
+ *  writing front.  Commit copies the set front named when it began,
+ *  which no advance writes until it is done, so the positions committed
+ *  all come from one advance and interrupts are never disabled.
+ *  \return the slots moved since last drawn (kept in moved), or 0
+ */
+u_int layerTableCommit(LayerTable *t);
+
+/** Render area (which must be within the screen).
+ *  Pixels not contained by a visible layer are set to bgColor.
+ */
+void layerTableDrawRegion(const LayerTable *t, const Region *area);
+
+/** Render the whole screen */
+void layerTableDraw(const LayerTable *t);
+
+/** Render the whole screen by the painter's algorithm (see layerPaint).
+ *  Faster than layerTableDraw for the first frame.
+ */
+void layerTablePaint(const LayerTable *t);
+
+/** Redraw the last and current bounds of the layers moved since last
+ *  drawn, and mark them drawn
+ */
+void layerTableDrawMoving(LayerTable *t);
+
+/** Advance, commit and redraw the moved layers, in one pass.  For
+ *  programs that advance in the main loop rather than in an ISR.
+ */
+void layerTableUpdate(LayerTable *t, const Region *fence);
+
+/** Mark the moved layers drawn, for callers that redraw them otherwise */
+#define layerTableDrawn(t) ((t)->moved = 0)
+
+#endif // layerTable_included
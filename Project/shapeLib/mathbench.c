@@ -0,0 +1,126 @@
+/** \file mathbench.c
+ *  \brief Measures the fixmath routines against plain C arithmetic.
+ *
+ *  Each routine is run BENCH_ITERATIONS times and the average cost,
+ *  in MCLK cycles per call (loop overhead removed), is displayed as
+ *  "name  fix  C", where C is the same result computed with C's
+ *  multiply and divide (libgcc loops on this MCU), if there is one.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "fixmath.h"
+
+#define BENCH_ITERATIONS 1000
+
+u_int bgColor = COLOR_BLACK;
+
+volatile int x = 117, y = -83, q = 181;	/* volatile: defeat constant folding */
+volatile u_char angle = 37;
+volatile u_int n = 41000;
+volatile int iSink;
+volatile u_int uSink;
+volatile u_char cSink;
+Vec2 va = {12, 140}, vb = {110, 25}, vSink;
+
+static unsigned long loopTicks;	/* cost of an empty loop */
+
+/** Cycles per iteration, less loop overhead */
+static u_int
+cyclesPerCall(unsigned long ticks)
+{
+  return ((ticks - loopTicks) * STOPWATCH_CYCLES_PER_TICK) / BENCH_ITERATIONS;
+}
+
+/** Displays a row; cTicks is 0 if there is no C equivalent */
+static void
+report(u_char row, char *name, unsigned long fixTicks, unsigned long cTicks)
+{
+  char num[6];
+  drawString5x7(2, row, name, COLOR_WHITE, bgColor);
+  formatNum(num, cyclesPerCall(fixTicks), 5);
+  drawString5x7(50, row, num, COLOR_GREEN, bgColor);
+  if (cTicks) {
+    formatNum(num, cyclesPerCall(cTicks), 5);
+    drawString5x7(90, row, num, COLOR_YELLOW, bgColor);
+  }
+}
+
+/** Squared distance with C's multiply */
+static u_int
+cDistSq(const Vec2 *a, const Vec2 *b)
+{
+  int dc = a->axes[0] - b->axes[0], dr = a->axes[1] - b->axes[1];
+  return dc * dc + dr * dr;
+}
+
+/** Square root by Newton's method, with C's divide */
+static u_char
+cSqrt(u_int m)
+{
+  u_int r = 255, s = (r + m / r) >> 1;
+  if (!m)
+    return 0;
+  while (s < r) {
+    r = s;
+    s = (r + m / r) >> 1;
+  }
+  return r;
+}
+
+/* Times the statement stmt, leaving the elapsed ticks in result */
+#define TIME(result, stmt) {				\
+    u_int i;						\
+    stopwatchStart();					\
+    for (i = 0; i < BENCH_ITERATIONS; i++) { stmt; }	\
+    result = stopwatchRead();				\
+  }
+
+int
+main()
+{
+  unsigned long fixTicks, cTicks;
+  u_char row = 20;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/* GIE on: stopwatch needs its overflow interrupt */
+  clearScreen(bgColor);
+  drawString5x7(2, 5, "op      fix     C", COLOR_WHITE, bgColor);
+
+  TIME(loopTicks, asm volatile(""));
+
+  TIME(fixTicks, iSink = fixSin(angle));
+  report(row += 10, "sin", fixTicks, 0);
+
+  TIME(fixTicks, iSink = fixCos(angle));
+  report(row += 10, "cos", fixTicks, 0);
+
+  TIME(fixTicks, iSink = fixMulQ8(x, q));
+  TIME(cTicks, iSink = (int)((long)x * q / 256));
+  report(row += 10, "mulQ8", fixTicks, cTicks);
+
+  TIME(fixTicks, fixPolar(&vSink, angle, x));
+  report(row += 10, "polar", fixTicks, 0);
+
+  TIME(fixTicks, cSink = fixAtan2(y, x));
+  report(row += 10, "atan2", fixTicks, 0);
+
+  TIME(fixTicks, vSink = va; fixNormalize(&vSink, FIX_ONE));
+  report(row += 10, "normal", fixTicks, 0);
+
+  TIME(fixTicks, uSink = fixSquare(y));
+  TIME(cTicks, uSink = y * y);
+  report(row += 10, "square", fixTicks, cTicks);
+
+  TIME(fixTicks, uSink = fixDistSq(&va, &vb));
+  TIME(cTicks, uSink = cDistSq(&va, &vb));
+  report(row += 10, "distSq", fixTicks, cTicks);
+
+  TIME(fixTicks, cSink = fixSqrt(n));
+  TIME(cTicks, cSink = cSqrt(n));
+  report(row += 10, "sqrt", fixTicks, cTicks);
+
+  or_sr(0x10);			/* CPU off */
+}
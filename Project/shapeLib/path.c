@@ -0,0 +1,105 @@
+#include "path.h"
+
+/** Each curve's a1, a2 and a3: e(u) = a1 u + a2 u^2 + a3 u^3, e(1) = 1 */
+static const signed char pathEases[][3] = {
+  {1, 0, 0},			/* PATH_LINEAR */
+  {0, 1, 0},			/* PATH_EASE_IN */
+  {2, -1, 0},			/* PATH_EASE_OUT */
+  {0, 3, -2},			/* PATH_EASE_IN_OUT */
+};
+
+/** Start the segment to points[next]: set up its difference table.
+ *
+ *  In units of 1/N^3 pixel, the offset after t of N ticks is
+ *  F(t) = D (a1 N^2 t + a2 N t^2 + a3 t^3), whose forward differences
+ *  at t = 0 are below.  F(N) = D N^3, so the segment ends on the point.
+ */
+static void
+pathSegment(PathFollower *f)
+{
+  const PathPoint *p = &f->points[f->next];
+  const signed char *a = pathEases[p->ease];
+  long n = p->ticks, n2 = n * n;
+  u_char axis;
+  f->unit = n2 * n;
+  f->ticksLeft = p->ticks;
+  for (axis = 0; axis < 2; axis++) {
+    PathAxis *ax = &f->axes[axis];
+    long d = p->pos.axes[axis] - ax->pos;
+    ax->frac = 0;
+    ax->d1 = d * (a[0] * n2 + a[1] * n + a[2]);
+    ax->d2 = d * (2 * a[1] * n + 6 * a[2]);
+    ax->d3 = d * 6 * a[2];
+  }
+}
+
+/** Start from the layer's next position toward points[next], if any */
+static void
+pathStart(PathFollower *f, LayerTable *t, u_char slot)
+{
+  Vec2 pos;
+  pvec2Unpack(&pos, t->layer[slot]->posNext);
+  f->slot = slot;
+  f->axes[0].pos = pos.axes[0];
+  f->axes[1].pos = pos.axes[1];
+  f->ticksLeft = 0;
+  if (f->next < f->count)
+    pathSegment(f);
+  layerTableSetVelocity(t, slot, 0, 0); /* committed and redrawn, but not stepped */
+}
+
+void
+pathFollow(PathFollower *f, LayerTable *t, u_char slot,
+	   const PathPoint *points, u_char count, u_char loop)
+{
+  pvec2Pack(&t->layer[slot]->posNext, &points[0].pos);
+  f->points = points;
+  f->count = count;
+  f->next = 1;
+  f->loop = loop;
+  pathStart(f, t, slot);
+}
+
+void
+pathTween(PathFollower *f, LayerTable *t, u_char slot, const PathPoint *to)
+{
+  f->points = to;
+  f->count = 1;
+  f->next = 0;
+  f->loop = 0;
+  pathStart(f, t, slot);
+}
+
+void
+pathAdvance(PathFollower *followers, u_char count, LayerTable *t)
+{
+  for (; count; count--, followers++) {
+    PathFollower *f = followers;
+    Vec2 pos;
+    u_char axis;
+    if (!f->ticksLeft)
+      continue;
+    for (axis = 0; axis < 2; axis++) { /* DDA step */
+      PathAxis *ax = &f->axes[axis];
+      ax->frac += ax->d1;
+      ax->d1 += ax->d2;
+      ax->d2 += ax->d3;
+      while (ax->frac >= f->unit) {	/* a carry per pixel moved */
+	ax->frac -= f->unit;
+	ax->pos++;
+      }
+      while (ax->frac < 0) {
+	ax->frac += f->unit;
+	ax->pos--;
+      }
+      pos.axes[axis] = ax->pos;
+    }
+    pvec2Pack(&t->layer[f->slot]->posNext, &pos);
+    if (--f->ticksLeft)
+      continue;
+    if (++f->next == f->count && f->loop)	/* reached the point */
+      f->next = 0;
+    if (f->next < f->count)
+      pathSegment(f);
+  }
+}
@@ -0,0 +1,76 @@
+/** \file path.h
+ *  \brief Layers that follow waypoint paths and tweens, without multiplying per tick.
+ *
+ *  A path is a const array of PathPoints: where to go, how many ticks
+ *  to take getting there and how to ease along the way.  A
+ *  PathFollower moves one layer of a LayerTable along a path, or
+ *  along a single tween from wherever the layer is.
+ *
+ *  Each easing curve is a polynomial e(u) = a1 u + a2 u^2 + a3 u^3 of
+ *  the fraction u of the segment's ticks gone (0 to 1).  Starting a
+ *  segment of N ticks covering D pixels sets up its difference table:
+ *  the first three forward differences of D e(t/N), in units of
+ *  1/N^3 pixel, which are all integers.  After that each tick is an
+ *  integer DDA step per axis: three additions of the differences,
+ *  then a carry into the pixel position for each pixel moved.  No
+ *  multiplication or division is done except when a segment starts,
+ *  and the follower lands exactly on each waypoint.
+ *
+ *  A followed layer is a moving layer with zero velocity, so
+ *  layerTableAdvance skips it but still commits and redraws it.  Call
+ *  pathAdvance just before layerTableAdvance (in the same interrupt
+ *  handler or loop).  A followed layer may be solid: it is not swept
+ *  along its path, but layerTableAdvance pushes any layer it moves
+ *  onto back out of it, so nothing passes through it.
+ */
+#ifndef path_included
+#define path_included
+
+#include "shape.h"
+#include "layerTable.h"
+
+/** Easing curves, for getting to a PathPoint */
+#define PATH_LINEAR 0		/* constant speed */
+#define PATH_EASE_IN 1		/* accelerating from rest */
+#define PATH_EASE_OUT 2		/* decelerating to rest */
+#define PATH_EASE_IN_OUT 3	/* both (smoothstep) */
+
+typedef struct {
+  Vec2 pos;			/* screen position */
+  u_char ticks;			/* taken to get here, at least 1 */
+  u_char ease;			/* PATH_ curve */
+} PathPoint;
+
+typedef struct {
+  int pos;			/* pixel */
+  long frac;			/* past pos, in 1/ticks^3 pixels */
+  long d1, d2, d3;		/* forward differences of frac per tick */
+} PathAxis;
+
+typedef struct {
+  const PathPoint *points;	/* path being followed */
+  u_char count;			/* points on it */
+  u_char next;			/* index of the point being headed to */
+  u_char ticksLeft;		/* to get there; 0 once done */
+  u_char loop;			/* start over after the last point */
+  u_char slot;			/* layer moved */
+  long unit;			/* a pixel in frac: ticks^3 */
+  PathAxis axes[2];
+} PathFollower;
+
+/** Have the layer in slot follow count points from points[0] (where it
+ *  is put), and after the last point go back to the first if loop.
+ */
+void pathFollow(PathFollower *f, LayerTable *t, u_char slot,
+		const PathPoint *points, u_char count, u_char loop);
+
+/** Move the layer in slot from where it is to the point to, then stop */
+void pathTween(PathFollower *f, LayerTable *t, u_char slot, const PathPoint *to);
+
+/** Move each of count followers one tick along its path */
+void pathAdvance(PathFollower *followers, u_char count, LayerTable *t);
+
+/** Has the follower reached the end of its path (or tween)? */
+#define pathDone(f) (!(f)->ticksLeft)
+
+#endif // path_included
@@ -0,0 +1,101 @@
+#include "shape.h"
+
+/** Widen the spans of the rows edge (col, row) to (colEnd, rowEnd)
+ *  passes through, stepping one pixel at a time (Bresenham)
+ */
+static void
+abPolygonEdge(AbPolygon *polygon, int col, int row, int colEnd, int rowEnd)
+{
+  int dCol, dRow, colStep = 1, err;
+  signed char (*span)[2];
+  if (row > rowEnd) {		/* always step down */
+    int t = row; row = rowEnd; rowEnd = t;
+    t = col; col = colEnd; colEnd = t;
+  }
+  dCol = colEnd - col;
+  if (dCol < 0) {
+    dCol = -dCol;
+    colStep = -1;
+  }
+  dRow = row - rowEnd;		/* negative */
+  err = dCol + dRow;
+  span = &polygon->spans[row - polygon->top];
+  for (;;) {
+    int err2 = err + err;
+    if (col < (*span)[0]) (*span)[0] = col;
+    if (col > (*span)[1]) (*span)[1] = col;
+    if (col == colEnd && row == rowEnd)
+      break;
+    if (err2 >= dRow) {		/* step across */
+      err += dRow;
+      col += colStep;
+    }
+    if (err2 <= dCol) {		/* step down */
+      err += dCol;
+      row++;
+      span++;
+    }
+  }
+}
+
+int
+abPolygonInit(AbPolygon *polygon)
+{
+  const signed char (*vertex)[2] = polygon->vertices;
+  u_char i, count = polygon->count;
+  int top = vertex[0][1], bottom = top, left = vertex[0][0], right = left;
+  for (i = 1; i < count; i++) {	/* bounds */
+    int col = vertex[i][0], row = vertex[i][1];
+    if (row < top) top = row;
+    if (row > bottom) bottom = row;
+    if (col < left) left = col;
+    if (col > right) right = col;
+  }
+  polygon->top = top;
+  polygon->height = 0;		/* empty unless spans has room */
+  if (bottom - top >= polygon->maxRows)
+    return 0;
+  polygon->height = bottom - top + 1;
+  polygon->left = left;
+  polygon->right = right;
+  for (i = 0; i < polygon->height; i++) { /* empty spans */
+    polygon->spans[i][0] = right;
+    polygon->spans[i][1] = left;
+  }
+  for (i = 0; i < count; i++) {	/* each edge, wrapping to the first vertex */
+    const signed char *from = vertex[i], *to = vertex[i + 1 < count ? i + 1 : 0];
+    abPolygonEdge(polygon, from[0], from[1], to[0], to[1]);
+  }
+  return 1;
+}
+
+void
+abPolygonGetBounds(const AbPolygon *polygon, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] + polygon->left;
+  bounds->topLeft.axes[1] = centerPos->axes[1] + polygon->top;
+  bounds->botRight.axes[0] = centerPos->axes[0] + polygon->right;
+  bounds->botRight.axes[1] = centerPos->axes[1] + polygon->top + polygon->height - 1;
+}
+
+// true if pixel is within its row's span
+int
+abPolygonCheck(const AbPolygon *polygon, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  u_int row = pixel->axes[1] - centerPos->axes[1] - polygon->top; /* negative wraps high */
+  if (row >= polygon->height)
+    return 0;
+  return col >= polygon->spans[row][0] && col <= polygon->spans[row][1];
+}
+
+// row's span, clipped to pixels col..col+15
+u_int
+abPolygonCoverage(const AbPolygon *polygon, const Vec2 *centerPos, int col, int row)
+{
+  int center = centerPos->axes[0];
+  row -= centerPos->axes[1] + polygon->top;
+  if ((u_int)row >= polygon->height)
+    return 0;
+  return coverageSpan(col, center + polygon->spans[row][0], center + polygon->spans[row][1]);
+}
@@ -0,0 +1,86 @@
+#include "pool.h"
+
+void
+poolInit(Pool *p, void *items, u_int size, u_char count)
+{
+  u_char *item = items;
+  p->free = 0;
+  p->used = p->peak = 0;
+  p->capacity = count;
+  item += (u_int)count * size;
+  while (count--) {		/* push them back to front: the first is allocated first */
+    item -= size;
+    ((PoolItem *)item)->next = p->free;
+    p->free = (PoolItem *)item;
+  }
+}
+
+void *
+poolAlloc(Pool *p)
+{
+  PoolItem *item = p->free;
+  if (item) {
+    p->free = item->next;
+    if (++p->used > p->peak)
+      p->peak = p->used;
+  }
+  return item;
+}
+
+void
+poolFree(Pool *p, void *item)
+{
+  ((PoolItem *)item)->next = p->free;
+  p->free = item;
+  p->used--;
+}
+
+void
+layerPoolInit(LayerPool *lp, LayerTable *table, Layer *layers, u_char count)
+{
+  poolInit(&lp->layers, layers, sizeof(Layer), count);
+  lp->table = table;
+  lp->spawned = 0;
+}
+
+u_char
+layerPoolSpawn(LayerPool *lp, const LayerDesc *desc, const Vec2 *pos, int col, int row)
+{
+  LayerTable *t = lp->table;
+  Layer *l = poolAlloc(&lp->layers);
+  u_char slot;
+  if (!l)
+    return LAYER_NONE;
+  l->desc = desc;
+  pvec2Pack(&l->pos, pos);
+  l->next = 0;
+  slot = layerTableInsert(t, l);
+  if (slot == LAYER_NONE) {
+    poolFree(&lp->layers, l);
+    return LAYER_NONE;
+  }
+  if (col || row)
+    layerTableSetVelocity(t, slot, col, row);
+  t->moved |= layerTableBit(slot); /* drawn with the layers that moved */
+  lp->spawned |= layerTableBit(slot);
+  return slot;
+}
+
+void
+layerPoolDespawn(LayerPool *lp, u_char slot)
+{
+  LayerTable *t = lp->table;
+  Layer *l = t->layer[slot];
+  u_int bit = layerTableBit(slot);
+  Region bounds;
+  Vec2 center;
+  /* where it was last drawn: not yet at pos if it moved since */
+  pvec2Unpack(&center, (t->moved & bit) ? l->posLast : l->pos);
+  layerTableRemove(t, slot);
+  lp->spawned &= ~bit;
+  abShapeGetBounds(l->desc->abShape, &center, &bounds);
+  regionClipScreen(&bounds);
+  if (!regionIsEmpty(&bounds))
+    layerTableDrawRegion(t, &bounds);
+  poolFree(&lp->layers, l);
+}
@@ -0,0 +1,69 @@
+/** \file pool.h
+ *  \brief Fixed-capacity pools, and layers spawned from them into a LayerTable.
+ *
+ *  There is no heap to spare on this MCU, so objects created at run
+ *  time (layers, shapes sized at run time, game records) come from
+ *  pools: arrays of equal sized items set aside at compile time.
+ *  Free items are kept on a list threaded through the items
+ *  themselves, so allocating and freeing are constant time and cost
+ *  no RAM beyond the pool's header.
+ *
+ *  A LayerPool pairs a pool of Layers with a LayerTable.  Spawning a
+ *  layer takes a Layer from the pool and inserts it into the table,
+ *  moving if given a velocity (a layer's motion is kept in its table
+ *  slot), and has it drawn by the next layerTableDrawMoving.
+ *  Despawning removes it from the table, redraws where it was last
+ *  drawn and returns the Layer to the pool.
+ */
+#ifndef pool_included
+#define pool_included
+
+#include "shape.h"
+#include "layerTable.h"
+
+typedef struct PoolItem_s {	/* a free item */
+  struct PoolItem_s *next;
+} PoolItem;
+
+typedef struct {
+  PoolItem *free;		/* free items, or 0 */
+  u_char used, capacity;	/* items */
+  u_char peak;			/* most items used at once */
+} Pool;
+
+/** Set up a pool of count items, each size bytes (at least a pointer),
+ *  in the array items.
+ */
+void poolInit(Pool *p, void *items, u_int size, u_char count);
+
+/** \return a free item, or 0 if all are used */
+void *poolAlloc(Pool *p);
+
+/** Return item (from poolAlloc) to the pool */
+void poolFree(Pool *p, void *item);
+
+/** Set up pool p over the array items, e.g. poolInitArray(&p, rects) */
+#define poolInitArray(p, items) \
+  poolInit(p, items, sizeof((items)[0]), sizeof(items) / sizeof((items)[0]))
+
+typedef struct {
+  Pool layers;			/* of Layers */
+  LayerTable *table;		/* spawned into */
+  u_int spawned;		/* slots of the table holding this pool's layers */
+} LayerPool;
+
+/** Set up a LayerPool of count Layers (the array layers) spawned into table */
+void layerPoolInit(LayerPool *lp, LayerTable *table, Layer *layers, u_char count);
+
+/** Spawn a layer showing desc at pos, behind the table's other layers,
+ *  moving by (col, row) in Q8.8 pixels per advance unless both are 0.
+ *  \return its slot, or LAYER_NONE if the pool or table is full
+ */
+u_char layerPoolSpawn(LayerPool *lp, const LayerDesc *desc, const Vec2 *pos, int col, int row);
+
+/** Remove the layer spawned into slot, redraw where it was last drawn
+ *  (so call where drawing is allowed) and return it to the pool.
+ */
+void layerPoolDespawn(LayerPool *lp, u_char slot);
+
+#endif // pool_included
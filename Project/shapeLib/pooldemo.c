@@ -0,0 +1,144 @@
+/** \file pooldemo.c
+ *  \brief Stress test of pools: spawns and despawns moving layers continuously.
+ *
+ *  Every SPAWN_FRAMES frames a sprite is spawned as a moving layer
+ *  from a LayerPool, with a random size, color, position and velocity,
+ *  and lives for a random number of frames before being despawned.
+ *  There are sprites enough to fill the table, and they are spawned
+ *  faster than they die, so the pool and table run full.  The number
+ *  spawned, spawns refused because the pool or table was full, and
+ *  the most sprites alive at once are displayed below the field.
+ *
+ *  Every size and color of sprite has a const LayerDesc in flash, so a
+ *  sprite's RAM is its Layer and a byte of life.  With the 256 byte
+ *  LayerTable, globals come to about 460 bytes of the 512.
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "pool.h"
+
+#define SPRITES (LAYER_TABLE_SIZE - 1)	/* with the field, fills the table */
+#define SPAWN_FRAMES 2		/* frames between spawns */
+
+u_int bgColor = COLOR_BLACK;
+
+static const AbRect sizes[] = {
+  {abRectGetBounds, abRectCheck, abRectCoverage, {2,2}},
+  {abRectGetBounds, abRectCheck, abRectCoverage, {4,4}},
+  {abRectGetBounds, abRectCheck, abRectCoverage, {5,5}},
+  {abRectGetBounds, abRectCheck, abRectCoverage, {7,7}},
+};
+const AbRectOutline fieldOutline = {
+  abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineCoverage,
+  {screenWidth/2 - 2, screenHeight/2 - 12}
+};
+const LayerDesc whiteField = {(const AbShape *)&fieldOutline, COLOR_WHITE};
+
+Layer fieldLayer = {
+  &whiteField,
+  pvec2(screenWidth/2, screenHeight/2 - 8),
+  0, 0,
+  0
+};
+
+/** A sprite of each color, of one size */
+#define SPRITE_COLORS(size)						\
+  {{(const AbShape *)&sizes[size], COLOR_RED},				\
+   {(const AbShape *)&sizes[size], COLOR_GREEN},			\
+   {(const AbShape *)&sizes[size], COLOR_YELLOW},			\
+   {(const AbShape *)&sizes[size], COLOR_CYAN},				\
+   {(const AbShape *)&sizes[size], COLOR_MAGENTA},			\
+   {(const AbShape *)&sizes[size], COLOR_ORANGE},			\
+   {(const AbShape *)&sizes[size], COLOR_SKY_BLUE},			\
+   {(const AbShape *)&sizes[size], COLOR_GRAY}}
+
+static const LayerDesc spriteDescs[4][8] = {	/* by size, then color */
+  SPRITE_COLORS(0), SPRITE_COLORS(1), SPRITE_COLORS(2), SPRITE_COLORS(3)
+};
+
+Layer layers[SPRITES];
+u_char life[SPRITES];		/* by item of layers: frames left */
+LayerPool layerPool;
+LayerTable table;
+Region fence;
+u_int spawns, refused;
+
+/** 16-bit xorshift */
+static u_int
+nextRandom()
+{
+  static u_int seed = 0xace1;
+  seed ^= seed << 7;
+  seed ^= seed >> 9;
+  seed ^= seed << 8;
+  return seed;
+}
+
+/** Spawn a sprite of random size and color, somewhere near the middle */
+static void
+spawn()
+{
+  u_int r = nextRandom(), v = nextRandom();
+  Vec2 pos;
+  u_char slot;
+  pos.axes[0] = screenWidth/2 - 16 + ((r >> 5) & 31);
+  pos.axes[1] = screenHeight/2 - 24 + ((r >> 10) & 31);
+  slot = layerPoolSpawn(&layerPool, &spriteDescs[r & 3][(r >> 2) & 7], &pos,
+			(int)(v & 0x3ff) - 0x200, (int)((v >> 6) & 0x3ff) - 0x200); /* +-2 pixels */
+  if (slot == LAYER_NONE) {
+    refused++;
+    return;
+  }
+  life[table.layer[slot] - layers] = 16 + (v & 31);
+  spawns++;
+}
+
+/** Despawn the sprites whose lives have run out */
+static void
+despawnExpired()
+{
+  u_char slot;
+  u_int spawned;
+  for (slot = 0, spawned = layerPool.spawned; spawned; slot++, spawned >>= 1) {
+    if ((spawned & 1) && !--life[table.layer[slot] - layers])
+      layerPoolDespawn(&layerPool, slot);
+  }
+}
+
+static void
+report()
+{
+  char num[6];
+  formatNum(num, spawns, 5);
+  drawString5x7(2, screenHeight - 8, num, COLOR_GREEN, bgColor);
+  formatNum(num, refused, 5);
+  drawString5x7(44, screenHeight - 8, num, COLOR_YELLOW, bgColor);
+  formatNum(num, layerPool.layers.peak, 5);
+  drawString5x7(86, screenHeight - 8, num, COLOR_WHITE, bgColor);
+}
+
+int
+main()
+{
+  u_char frame = 0;
+  configureClocks();
+  lcd_init();
+
+  layerTableInit(&table);
+  layerPoolInit(&layerPool, &table, layers, SPRITES);
+  layerTableInsert(&table, &fieldLayer);
+  layerGetBounds(&fieldLayer, &fence);
+  layerTablePaint(&table);
+
+  for (;;) {
+    layerTableUpdate(&table, &fence);
+    despawnExpired();
+    if (++frame % SPAWN_FRAMES == 0)
+      spawn();
+    if (frame == 0)		/* every 256 frames */
+      report();
+    __delay_cycles(400000);	/* 1/40 s */
+  }
+}
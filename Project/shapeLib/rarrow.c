@@ -24,6 +24,24 @@ abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel)
   return within;
 }
   
+/** Coverage function required by AbShape
+ *  abRArrowCoverage computes which of pixels col..col+15 of row are in the right arrow
+ */
+u_int
+abRArrowCoverage(const AbRArrow *arrow, const Vec2 *centerPos, int col, int row)
+{
+  int size = arrow->size;
+  int halfSize = size/2, quarterSize = halfSize/2;
+  int tipCol = centerPos->axes[0];
+  row -= centerPos->axes[1];
+  row = (row >= 0) ? row : -row;/* row = |row| */
+  if (row <= quarterSize)	/* through tip and stem */
+    return coverageSpan(col, tipCol - size, tipCol - row);
+  if (row <= halfSize)		/* tip only */
+    return coverageSpan(col, tipCol - halfSize, tipCol - row);
+  return 0;
+}
+
 /** Check function required by AbShape
  *  abRArrowGetBounds computes a right arrow's bounding box
  */
@@ -15,6 +15,17 @@ abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
   return within;
 }
 
+// pixels col..col+15 of row within rect centered at centerPos
+u_int
+abRectCoverage(const AbRect *rect, const Vec2 *centerPos, int col, int row)
+{
+  int halfCols = rect->halfSize.axes[0], halfRows = rect->halfSize.axes[1];
+  row -= centerPos->axes[1];
+  if (row < -halfRows || row > halfRows)
+    return 0;
+  return coverageSpan(col, centerPos->axes[0] - halfCols, centerPos->axes[0] + halfCols);
+}
+
 // compute bounding box in screen coordinates for rect at centerPos
 void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds)
 {
@@ -41,6 +52,21 @@ abRectOutlineCheck(const AbRectOutline *rect, const Vec2 *centerPos, const Vec2
 	   (col >= bounds.topLeft.axes[0] && col <= bounds.botRight.axes[0]))
 	  );
 }
+
+// pixels col..col+15 of row on the outline of rect centered at centerPos
+u_int
+abRectOutlineCoverage(const AbRectOutline *rect, const Vec2 *centerPos, int col, int row)
+{
+  int halfRows = rect->halfSize.axes[1];
+  int left = centerPos->axes[0] - rect->halfSize.axes[0];
+  int right = centerPos->axes[0] + rect->halfSize.axes[0];
+  row -= centerPos->axes[1];
+  if (row < -halfRows || row > halfRows)
+    return 0;
+  if (row == -halfRows || row == halfRows) /* top or bottom edge */
+    return coverageSpan(col, left, right);
+  return coverageSpan(col, left, left) | coverageSpan(col, right, right);
+}
  
 // compute bounding box in screen coordinates for rect at centerPos
 void abRectOutlineGetBounds(const AbRectOutline *rect, const Vec2 *centerPos, Region *bounds)
@@ -8,10 +8,95 @@ regionUnion(Region *rUnion, const Region *r1, const Region *r2)
   vec2Max(&rUnion->botRight, &r1->botRight, &r2->botRight);
 }
 
+static const Vec2 screenLast = {screenWidth-1, screenHeight-1}; /* bottom-right pixel */
+
 // Trims extent of region to screen bounds
 void regionClipScreen(Region *r)
 {
   vec2Max(&r->topLeft, &r->topLeft, &vec2Zero);
-  vec2Min(&r->botRight, &r->botRight, &screenSize);
+  vec2Min(&r->botRight, &r->botRight, &screenLast);
+}
+
+int
+regionIsEmpty(const Region *r)
+{
+  return (r->topLeft.axes[0] > r->botRight.axes[0] ||
+	  r->topLeft.axes[1] > r->botRight.axes[1]);
 }
 
+// Slab test, one axis at a time: each axis gives the interval of the
+// step during which the boxes overlap on it; they meet at the latest
+// start, if that precedes the earliest end.
+u_int
+regionSweep(const Region *mover, const Vec2 *velocity, const Region *obstacle, u_char *axis)
+{
+  long enter = -1, exit = REGION_SWEEP_STEP, touch = 0; /* Q8 times */
+  u_char a;
+  for (a = 0; a < 2; a++) {
+    int v = velocity->axes[a];
+    int moverLo = mover->topLeft.axes[a], moverHi = mover->botRight.axes[a];
+    int obstacleLo = obstacle->topLeft.axes[a], obstacleHi = obstacle->botRight.axes[a];
+    int from, to;		/* distances along v over which they overlap */
+    long axisEnter, axisExit;
+    if (v == 0) {
+      if (moverHi < obstacleLo || moverLo > obstacleHi)
+	return REGION_SWEEP_MISS; /* never overlap on this axis */
+      continue;
+    }
+    if (v > 0) {
+      from = obstacleLo - moverHi;
+      to = obstacleHi - moverLo;
+    } else {
+      v = -v;
+      from = moverLo - obstacleHi;
+      to = moverHi - obstacleLo;
+    }
+    axisEnter = from > 0 ? ((long)from << 8) / v : -1;
+    axisExit = ((long)to << 8) / v;
+    if (axisEnter > enter) {
+      enter = axisEnter;
+      touch = ((long)(from - 1) << 8) / v;
+      *axis = a;
+    }
+    if (axisExit < exit)
+      exit = axisExit;
+  }
+  if (enter < 0)		/* overlapping on every axis at the start */
+    return exit < 0 ? REGION_SWEEP_MISS : REGION_SWEEP_OVERLAP;
+  if (enter > exit)
+    return REGION_SWEEP_MISS;
+  return touch;
+}
+
+u_char
+regionPushOut(const Region *mover, const Region *obstacle, int *push)
+{
+  u_char a, axis = 0;
+  int best = 0x7fff;
+  for (a = 0; a < 2; a++) {
+    int after = obstacle->botRight.axes[a] + 1 - mover->topLeft.axes[a];	/* > 0 */
+    int before = obstacle->topLeft.axes[a] - 1 - mover->botRight.axes[a];	/* < 0 */
+    int d = (after < -before) ? after : before;
+    if ((d < 0 ? -d : d) < best) {
+      best = d < 0 ? -d : d;
+      *push = d;
+      axis = a;
+    }
+  }
+  return axis;
+}
+
+// pack both corners (clamped to the clip guard)
+void
+regionPack(PRegion *packed, const Region *r)
+{
+  pvec2Pack(&packed->topLeft, &r->topLeft);
+  pvec2Pack(&packed->botRight, &r->botRight);
+}
+
+void
+regionUnpack(Region *r, const PRegion *packed)
+{
+  pvec2Unpack(&r->topLeft, packed->topLeft);
+  pvec2Unpack(&r->botRight, packed->botRight);
+}
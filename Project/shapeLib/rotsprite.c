@@ -0,0 +1,76 @@
+#include "shape.h"
+
+#define FLIP_COLS 1		/* mirror left to right */
+#define FLIP_ROWS 2		/* mirror top to bottom */
+
+/** The stored frame for sprite's orientation, and how it must be flipped */
+static const AbSpanShape *
+abRotSpriteFrame(const AbRotSprite *sprite, u_char *flip)
+{
+  u_char orientation = sprite->orientation, half = sprite->steps >> 1;
+  *flip = 0;
+  if (orientation >= half) {	/* point reflection of half a turn less */
+    orientation -= half;
+    *flip = FLIP_COLS | FLIP_ROWS;
+  }
+  if (sprite->mirrored && orientation > (half >> 1)) {
+    orientation = half - orientation; /* flipped top to bottom */
+    *flip ^= FLIP_ROWS;
+  }
+  return sprite->frames[orientation];
+}
+
+void
+abRotSpriteGetBounds(const AbRotSprite *sprite, const Vec2 *centerPos, Region *bounds)
+{
+  u_char flip;
+  const AbSpanShape *frame = abRotSpriteFrame(sprite, &flip);
+  int left = frame->left, right = frame->right;
+  int top = frame->top, bottom = frame->top + frame->height - 1;
+  if (flip & FLIP_COLS) {
+    int t = left; left = -right; right = -t;
+  }
+  if (flip & FLIP_ROWS) {
+    int t = top; top = -bottom; bottom = -t;
+  }
+  bounds->topLeft.axes[0] = centerPos->axes[0] + left;
+  bounds->topLeft.axes[1] = centerPos->axes[1] + top;
+  bounds->botRight.axes[0] = centerPos->axes[0] + right;
+  bounds->botRight.axes[1] = centerPos->axes[1] + bottom;
+}
+
+// check the flipped pixel against the stored frame
+int
+abRotSpriteCheck(const AbRotSprite *sprite, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  u_char flip;
+  const AbSpanShape *frame = abRotSpriteFrame(sprite, &flip);
+  Vec2 framePixel = *pixel;
+  if (flip & FLIP_COLS)
+    framePixel.axes[0] = 2 * centerPos->axes[0] - pixel->axes[0];
+  if (flip & FLIP_ROWS)
+    framePixel.axes[1] = 2 * centerPos->axes[1] - pixel->axes[1];
+  return abSpanCheck(frame, centerPos, &framePixel);
+}
+
+// union of the (flipped) row's spans, clipped to pixels col..col+15
+u_int
+abRotSpriteCoverage(const AbRotSprite *sprite, const Vec2 *centerPos, int col, int row)
+{
+  u_char flip, span, end;
+  const AbSpanShape *frame = abRotSpriteFrame(sprite, &flip);
+  int center = centerPos->axes[0];
+  u_int coverage = 0;
+  row -= centerPos->axes[1];
+  if (flip & FLIP_ROWS)
+    row = -row;
+  row -= frame->top;
+  if ((u_int)row >= frame->height)
+    return 0;
+  for (span = frame->rows[row], end = frame->rows[row + 1]; span < end; span++)
+    if (flip & FLIP_COLS)
+      coverage |= coverageSpan(col, center - frame->spans[span][1], center - frame->spans[span][0]);
+    else
+      coverage |= coverageSpan(col, center + frame->spans[span][0], center + frame->spans[span][1]);
+  return coverage;
+}
@@ -0,0 +1,150 @@
+#include "shape.h"
+
+/** A scaled shape cached in the arena, followed by its tables */
+typedef struct ScaledEntry_s {
+  const AbShape *source;
+  u_int scale;
+  u_int size;			/* bytes, including tables; even */
+  AbSpanShape shape;
+} ScaledEntry;
+
+static u_int arena[ABSCALED_ARENA_SIZE / sizeof(u_int)]; /* u_int keeps entries aligned */
+static u_int arenaUsed;		/* bytes */
+
+/** How scaled (dest) pixels map back to source pixels */
+typedef struct {
+  const AbShape *source;
+  u_int inverse;		/* Q8.8 source pixels per dest pixel */
+  int left, right;		/* dest cols to sample */
+} ScaledSampler;
+
+/** Sample the dest row whose source row is srcRow (relative to center).
+ *  Stores its spans in spans unless it is 0, and widens *left, *right.
+ *  \return the number of spans
+ */
+static u_char
+scaledRowSpans(const ScaledSampler *sampler, int srcRow, signed char (*spans)[2], int *left, int *right)
+{
+  long srcCol = (long)sampler->left * sampler->inverse + 128; /* Q8.8, rounded */
+  Vec2 pixel;
+  int col, inSpan = 0;
+  u_char count = 0;
+  pixel.axes[1] = screenCenter.axes[1] + srcRow;
+  for (col = sampler->left; col <= sampler->right + 1; col++, srcCol += sampler->inverse) {
+    int in = 0;
+    if (col <= sampler->right) {
+      pixel.axes[0] = screenCenter.axes[0] + (int)(srcCol >> 8);
+      in = abShapeCheck(sampler->source, &screenCenter, &pixel);
+    }
+    if (in && !inSpan) {	/* span starts */
+      if (spans) spans[count][0] = col;
+      if (col < *left) *left = col;
+    } else if (!in && inSpan) {	/* span ended at col - 1 */
+      if (spans) spans[count][1] = col - 1;
+      if (col - 1 > *right) *right = col - 1;
+      count++;
+    }
+    inSpan = in;
+  }
+  return count;
+}
+
+int
+abScaledSetScale(AbScaled *s, u_int scale)
+{
+  ScaledSampler sampler;
+  ScaledEntry *e;
+  Region bounds;
+  u_char *rows;
+  signed char (*spans)[2];
+  u_int used, size, spanCount = 0;
+  int row, dTop, dBottom, top = 0x7fff, bottom = -0x7fff, left = 0x7fff, right = -0x7fff;
+  long srcRow;
+
+  if (scale < 2)		/* its inverse would not fit in a u_int */
+    return 0;
+  for (used = 0; used < arenaUsed; used += e->size) { /* already cached? */
+    e = (ScaledEntry *)((u_char *)arena + used);
+    if (e->source == s->shape && e->scale == scale) {
+      s->scaled = &e->shape;
+      s->scale = scale;
+      return 1;
+    }
+  }
+
+  /* source bounds about the screen center, where a whole shape fits on screen */
+  abShapeGetBounds(s->shape, &screenCenter, &bounds);
+  vec2Sub(&bounds.topLeft, &bounds.topLeft, &screenCenter);
+  vec2Sub(&bounds.botRight, &bounds.botRight, &screenCenter);
+  sampler.source = s->shape;
+  sampler.inverse = 0x10000L / scale;
+  sampler.left = (((long)bounds.topLeft.axes[0] * scale) >> 8) - 1;
+  sampler.right = (((long)bounds.botRight.axes[0] * scale) >> 8) + 1;
+  dTop = (((long)bounds.topLeft.axes[1] * scale) >> 8) - 1;
+  dBottom = (((long)bounds.botRight.axes[1] * scale) >> 8) + 1;
+
+  /* measure: rows with spans, and how many spans */
+  for (row = dTop, srcRow = (long)dTop * sampler.inverse + 128; row <= dBottom;
+       row++, srcRow += sampler.inverse) {
+    u_char count = scaledRowSpans(&sampler, (int)(srcRow >> 8), 0, &left, &right);
+    if (count) {
+      if (row < top) top = row;
+      bottom = row;
+      spanCount += count;
+    }
+  }
+  if (bottom < top)		/* scaled to nothing */
+    top = bottom = left = right = 0;
+  size = (sizeof(ScaledEntry) + 2 * spanCount + (bottom - top + 2) + 1) & ~1;
+  if (arenaUsed + size > ABSCALED_ARENA_SIZE || spanCount > 255)
+    return 0;
+  if (left < -128 || right > 127 || top < -128 || bottom > 127)
+    return 0;			/* spans and bounds are signed chars */
+
+  /* fill in the entry: spans then rows after the header */
+  e = (ScaledEntry *)((u_char *)arena + arenaUsed);
+  spans = (signed char (*)[2])(e + 1);
+  rows = (u_char *)(spans + spanCount);
+  spanCount = 0;
+  for (row = top, srcRow = (long)top * sampler.inverse + 128; row <= bottom;
+       row++, srcRow += sampler.inverse) {
+    rows[row - top] = spanCount;
+    spanCount += scaledRowSpans(&sampler, (int)(srcRow >> 8), spans + spanCount, &left, &right);
+  }
+  rows[bottom - top + 1] = spanCount;
+  e->source = s->shape;
+  e->scale = scale;
+  e->size = size;
+  e->shape.getBounds = abSpanGetBounds;
+  e->shape.check = abSpanCheck;
+  e->shape.coverage = abSpanCoverage;
+  e->shape.rows = rows;
+  e->shape.spans = (const signed char (*)[2])spans;
+  e->shape.top = top;
+  e->shape.height = spanCount ? bottom - top + 1 : 0;
+  e->shape.left = left;
+  e->shape.right = right;
+  arenaUsed += size;
+
+  s->scaled = &e->shape;
+  s->scale = scale;
+  return 1;
+}
+
+void
+abScaledGetBounds(const AbScaled *s, const Vec2 *centerPos, Region *bounds)
+{
+  abSpanGetBounds(s->scaled, centerPos, bounds);
+}
+
+int
+abScaledCheck(const AbScaled *s, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  return abSpanCheck(s->scaled, centerPos, pixel);
+}
+
+u_int
+abScaledCoverage(const AbScaled *s, const Vec2 *centerPos, int col, int row)
+{
+  return abSpanCoverage(s->scaled, centerPos, col, row);
+}
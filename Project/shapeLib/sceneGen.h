@@ -0,0 +1,195 @@
+/** \file sceneGen.h
+ *  \brief Generates a scene's layers and a renderer specialized to it.
+ *
+ *  A scene whose layers are fixed at compile time is declared once as
+ *  an X-macro listing its layers front (top) to back:
+ *
+ *    #define SCENE_CIRCLES	// uses kind abCircle, from circleLib
+ *    #define SCENE_NAME   myScene
+ *    #define SCENE_LAYERS(LAYER)					\
+ *      LAYER(ball,  abCircle, circle14, COLOR_RED,   64, 80)	\
+ *      LAYER(field, abRectOutline, fieldOutline, COLOR_BLACK, 64, 80)
+ *    #define SCENE_DEFINE	// only in the one .c file that owns the scene
+ *    #include <sceneGen.h>
+ *
+ *  Each LAYER(name, kind, shape, color, col, row) entry gives
+ *   - name: also becomes the layer's index, so the layer is myScene[name]
+ *   - kind: how shape is checked (see SCENE_CHECK_ below)
+ *   - shape: a const AbShape subtype, e.g. an AbRect
+ *   - color, col, row: the layer's color and initial center
+ *
+ *  Every includer gets an enum of layer indices (plus SCENE_NAME_count)
+ *  and declarations of:
+ *   - Layer SCENE_NAME[]: the layers, linked in order, so the generic
+ *     layerDraw(SCENE_NAME) etc. still work as a fallback
+ *   - SCENE_NAME_desc[]: the layers' flash-resident descriptors
+ *   - void SCENE_NAME_drawRegion(const Region *area): renders area,
+ *     probing the scene's shapes in order with the checks inlined
+ *     instead of calling through each AbShape's function pointer
+ *   - void SCENE_NAME_draw(): renders the whole screen the same way
+ *  With SCENE_DEFINE they are also defined.
+ *
+ *  SCENE_NAME, SCENE_LAYERS and SCENE_DEFINE are undefined at the end
+ *  so another scene may follow.
+ *
+ *  Kind abCircle needs circleLib, which itself needs shapeLib, so it
+ *  is only available if SCENE_CIRCLES is defined before sceneGen.h is
+ *  first included; abCircle.h is then included here.
+ */
+
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+#ifndef sceneGen_included
+#define sceneGen_included
+
+#define SCENE_CAT_(a, b) a ## b
+#define SCENE_CAT(a, b) SCENE_CAT_(a, b)
+
+/** Inline pixel checks, by kind.  Each matches the library's check of
+ *  the same name.  Use kind abShape for shapes with no inline check;
+ *  they are probed through their function pointer as usual.
+ */
+#define SCENE_CHECK_abShape(shape, center, pixel)		\
+  abShapeCheck((const AbShape *)(shape), center, pixel)
+
+#define SCENE_CHECK_abRect(shape, center, pixel)		\
+  sceneRectCheck(&(shape)->halfSize, center, pixel)
+
+#define SCENE_CHECK_abRectOutline(shape, center, pixel)		\
+  sceneRectOutlineCheck(&(shape)->halfSize, center, pixel)
+
+#define SCENE_CHECK_abRArrow(shape, center, pixel)		\
+  sceneRArrowCheck((shape)->size, center, pixel)
+
+#ifdef SCENE_CIRCLES		/* opted into circleLib */
+#include "abCircle.h"
+
+#define SCENE_CHECK_abCircle(shape, center, pixel)			\
+  abCircleContains(shape, center, pixel) /* inline, from abCircle.h */
+#endif // SCENE_CIRCLES
+
+/** As abRectCheck */
+static inline int
+sceneRectCheck(const Vec2 *halfSize, const Vec2 *center, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - center->axes[0], row = pixel->axes[1] - center->axes[1];
+  return (col >= -halfSize->axes[0] && col <= halfSize->axes[0] &&
+	  row >= -halfSize->axes[1] && row <= halfSize->axes[1]);
+}
+
+/** As abRectOutlineCheck */
+static inline int
+sceneRectOutlineCheck(const Vec2 *halfSize, const Vec2 *center, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - center->axes[0], row = pixel->axes[1] - center->axes[1];
+  int halfCols = halfSize->axes[0], halfRows = halfSize->axes[1];
+  if (col < -halfCols || col > halfCols || row < -halfRows || row > halfRows)
+    return 0;
+  return col == -halfCols || col == halfCols || row == -halfRows || row == halfRows;
+}
+
+/** As abRArrowCheck */
+static inline int
+sceneRArrowCheck(int size, const Vec2 *center, const Vec2 *pixel)
+{
+  int col = center->axes[0] - pixel->axes[0]; /* note that col is negated */
+  int row = pixel->axes[1] - center->axes[1];
+  int halfSize = size/2;
+  row = (row >= 0) ? row : -row;
+  if (col < 0)			/* right of arrow */
+    return 0;
+  if (col <= halfSize)		/* within arrow tip */
+    return row <= col;
+  return col <= size && row <= halfSize/2; /* within arrow stem */
+}
+
+#endif // sceneGen_included
+
+#define SCENE_LAYER_INDEX(name, kind, shape, color, col, row) name,
+
+enum {
+  SCENE_LAYERS(SCENE_LAYER_INDEX)
+  SCENE_CAT(SCENE_NAME, _count)
+};
+
+#undef SCENE_LAYER_INDEX
+
+extern const LayerDesc SCENE_CAT(SCENE_NAME, _desc)[];
+extern Layer SCENE_NAME[];
+void SCENE_CAT(SCENE_NAME, _drawRegion)(const Region *area);
+void SCENE_CAT(SCENE_NAME, _draw)();
+
+#ifdef SCENE_DEFINE
+
+#define SCENE_LAYER_DESC(name, kind, shape, color, col, row)	\
+  [name] = {(const AbShape *)&shape, color},
+
+const LayerDesc SCENE_CAT(SCENE_NAME, _desc)[] = {
+  SCENE_LAYERS(SCENE_LAYER_DESC)
+};
+
+#undef SCENE_LAYER_DESC
+
+#define SCENE_LAYER_INIT(name, kind, shape, color, col, row)		\
+  [name] = {								\
+    &SCENE_CAT(SCENE_NAME, _desc)[name],				\
+    pvec2(col, row), 0, 0,						\
+    name + 1 < SCENE_CAT(SCENE_NAME, _count) ? &SCENE_NAME[name + 1] : 0 \
+  },
+
+Layer SCENE_NAME[] = {
+  SCENE_LAYERS(SCENE_LAYER_INIT)
+};
+
+#undef SCENE_LAYER_INIT
+
+void
+SCENE_CAT(SCENE_NAME, _drawRegion)(const Region *area)
+{
+  Vec2 centers[SCENE_CAT(SCENE_NAME, _count)];
+  int row, col;
+
+#define SCENE_LAYER_CENTER(name, kind, shape, color, col, row)	\
+  pvec2Unpack(&centers[name], SCENE_NAME[name].pos);
+
+  SCENE_LAYERS(SCENE_LAYER_CENTER)	/* unpack each center once */
+
+#undef SCENE_LAYER_CENTER
+
+  if (regionIsEmpty(area))	/* e.g. bounds wholly off screen, clipped */
+    return;
+
+#define SCENE_LAYER_PROBE(name, kind, shape, color_, col, row)		\
+  if (SCENE_CHECK_ ## kind(&shape, &centers[name], &pixelPos))	\
+    color = color_;							\
+  else
+
+  lcd_setArea(area->topLeft.axes[0], area->topLeft.axes[1],
+	      area->botRight.axes[0], area->botRight.axes[1]);
+  for (row = area->topLeft.axes[1]; row <= area->botRight.axes[1]; row++) {
+    for (col = area->topLeft.axes[0]; col <= area->botRight.axes[0]; col++) {
+      Vec2 pixelPos = {col, row};
+      u_int color;
+      SCENE_LAYERS(SCENE_LAYER_PROBE)	/* first (top) layer containing pixel wins */
+	color = bgColor;
+      lcd_writeColor(color);
+    } // for col
+  } // for row
+
+#undef SCENE_LAYER_PROBE
+}
+
+void
+SCENE_CAT(SCENE_NAME, _draw)()
+{
+  static const Region screen = {{0, 0}, {screenWidth-1, screenHeight-1}};
+  SCENE_CAT(SCENE_NAME, _drawRegion)(&screen);
+}
+
+#endif // SCENE_DEFINE
+
+#undef SCENE_NAME
+#undef SCENE_LAYERS
+#undef SCENE_DEFINE
@@ -22,3 +22,37 @@ abShapeCheck(const AbShape *s, const Vec2 *centerPos, const Vec2 *pixelLoc)
   return (*s->check)(s, centerPos, pixelLoc);
 }
 
+
+u_int
+abShapeCoverage(const AbShape *s, const Vec2 *centerPos, int col, int row)
+{
+  u_int coverage = 0, bit;
+  Vec2 pixelLoc = {col, row};
+  if (s->coverage)
+    return (*s->coverage)(s, centerPos, col, row);
+  for (bit = 1; bit; bit <<= 1, pixelLoc.axes[0]++)
+    if ((*s->check)(s, centerPos, &pixelLoc))
+      coverage |= bit;
+  return coverage;
+}
+
+/* Lookups rather than shifts: the MSP430 shifts one bit per instruction */
+static const u_int coverageFrom[16] = { /* bits i..15 */
+  0xffff, 0xfffe, 0xfffc, 0xfff8, 0xfff0, 0xffe0, 0xffc0, 0xff80,
+  0xff00, 0xfe00, 0xfc00, 0xf800, 0xf000, 0xe000, 0xc000, 0x8000
+};
+
+static const u_int coverageThrough[16] = { /* bits 0..i */
+  0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff,
+  0x01ff, 0x03ff, 0x07ff, 0x0fff, 0x1fff, 0x3fff, 0x7fff, 0xffff
+};
+
+u_int
+coverageSpan(int col, int left, int right)
+{
+  left -= col;
+  right -= col;
+  if (right < 0 || left > 15 || left > right)
+    return 0;
+  return (left > 0 ? coverageFrom[left] : 0xffff) & (right < 15 ? coverageThrough[right] : 0xffff);
+}
@@ -48,20 +48,211 @@ void vec2Sub(Vec2 *result, const Vec2 *a1, const Vec2 *a2);
  */ 
 void vec2Abs(Vec2 *vec);
 
+/** PVec2 is a Vec2 packed into a single 16-bit word
+ *
+ *  Low byte is col, high byte is row.  Screen coordinates fit in a
+ *  byte, so a PVec2 needs half the RAM of a Vec2.
+ *
+ *  Positions are stored offset by PVEC2_GUARD so that shapes whose
+ *  center is slightly above or left of the screen remain representable.
+ *  pvec2Pack() clamps anything outside -PVEC2_GUARD..255-PVEC2_GUARD
+ *  (the "clip guard") rather than letting it wrap.
+ *
+ *  Vectors between positions (e.g. velocities) are packed with
+ *  pvec2Delta() as two signed bytes without the guard offset.
+ */
+typedef u_int PVec2;
+
+#define PVEC2_GUARD 32
+
+/** Packed position constant, usable in static initializers. */
+#define pvec2(col, row) \
+  ((PVec2)(((((row) + PVEC2_GUARD) & 0xff) << 8) | (((col) + PVEC2_GUARD) & 0xff)))
+
+/** Packed vector (no guard offset), usable in static initializers. */
+#define pvec2Delta(col, row) \
+  ((PVec2)((((row) & 0xff) << 8) | ((col) & 0xff)))
+
+/** Screen coordinates of a packed position */
+#define pvec2Col(p) ((int)((p) & 0xff) - PVEC2_GUARD)
+#define pvec2Row(p) ((int)((p) >> 8) - PVEC2_GUARD)
+
+/** Components of a packed vector (sign extended) */
+#define pvec2DeltaCol(p) ((int)(signed char)((p) & 0xff))
+#define pvec2DeltaRow(p) ((int)(signed char)((p) >> 8))
+
+/** Pack a position, clamping each axis to the representable range.
+ *  
+ *  \param packed (out) The packed position
+ *  \param vec (in) The position in screen coordinates
+ */ 
+void pvec2Pack(PVec2 *packed, const Vec2 *vec);
+
+/** Unpack a position into screen coordinates
+ */ 
+void pvec2Unpack(Vec2 *vec, PVec2 packed);
+
+/** SWAR (SIMD within a register) operations on PVec2s
+ *
+ *  Both axes are computed at once with a few word-wide logic ops and
+ *  no loops or calls.  Carries and borrows are kept from crossing from
+ *  the col byte into the row byte by handling each byte's top bit
+ *  (PVEC2_HIGH) separately from the other seven (PVEC2_LOW).
+ *
+ *  Add and sub wrap within each byte, so they work on positions and
+ *  on (signed) pvec2Delta vectors alike.  Comparisons, min, max and
+ *  clamp treat each byte as unsigned, which orders positions correctly
+ *  (this is why positions are stored with a guard offset).
+ */
+#define PVEC2_HIGH 0x8080
+#define PVEC2_LOW  0x7f7f
+
+/** Mask selecting one axis of a PVec2 (0 for col, 1 for row) */
+#define pvec2Lane(axis) ((axis) ? 0xff00 : 0x00ff)
+
+/** result = a + b, per axis */
+static inline PVec2
+pvec2Add(PVec2 a, PVec2 b)
+{
+  return ((a & PVEC2_LOW) + (b & PVEC2_LOW)) ^ ((a ^ b) & PVEC2_HIGH);
+}
+
+/** result = a - b, per axis */
+static inline PVec2
+pvec2Sub(PVec2 a, PVec2 b)
+{
+  return ((a | PVEC2_HIGH) - (b & PVEC2_LOW)) ^ ((a ^ ~b) & PVEC2_HIGH);
+}
+
+/** Expand each byte's top bit to fill the byte: 0x8000 -> 0xff00 */
+static inline PVec2
+pvec2SpreadHigh(PVec2 high)
+{
+  return (high << 1) - (high >> 7);
+}
+
+/** Compare a and b per axis
+ *
+ *  \return 0xff in each byte where a >= b, 0 elsewhere
+ */
+static inline PVec2
+pvec2Ge(PVec2 a, PVec2 b)
+{
+  PVec2 diff = pvec2Sub(a, b);
+  PVec2 borrow = ((~a & b) | (~(a ^ b) & diff)) & PVEC2_HIGH;
+  return pvec2SpreadHigh(~borrow & PVEC2_HIGH);
+}
+
+/** Bytes from a where mask is set, otherwise from b */
+static inline PVec2
+pvec2Select(PVec2 mask, PVec2 a, PVec2 b)
+{
+  return (a & mask) | (b & ~mask);
+}
+
+/** Per axis minimum */
+static inline PVec2
+pvec2Min(PVec2 a, PVec2 b)
+{
+  return pvec2Select(pvec2Ge(a, b), b, a);
+}
+
+/** Per axis maximum */
+static inline PVec2
+pvec2Max(PVec2 a, PVec2 b)
+{
+  return pvec2Select(pvec2Ge(a, b), a, b);
+}
+
+/** Clamp each axis of p to [lo, hi] */
+static inline PVec2
+pvec2Clamp(PVec2 p, PVec2 lo, PVec2 hi)
+{
+  return pvec2Min(pvec2Max(p, lo), hi);
+}
+
+/** Negate each axis of a pvec2Delta vector */
+static inline PVec2
+pvec2Neg(PVec2 v)
+{
+  return pvec2Sub(0, v);
+}
+
+/** Absolute value of each axis of a pvec2Delta vector */
+static inline PVec2
+pvec2Abs(PVec2 v)
+{
+  PVec2 sign = v & PVEC2_HIGH;
+  return (v ^ pvec2SpreadHigh(sign)) + (sign >> 7); /* cannot carry out of a byte */
+}
+
 /** Specifies a rectangular region
  */
 typedef struct {
   Vec2 topLeft, botRight;	/* in screen coordinates */
 } Region;		
 
+/** A Region with packed corners (4 bytes rather than 8)
+ */
+typedef struct {
+  PVec2 topLeft, botRight;
+} PRegion;
+
+/** Pack a region.  Corners beyond the clip guard are clamped.
+ */
+void regionPack(PRegion *packed, const Region *region);
+
+/** Unpack a region into screen coordinates
+ */
+void regionUnpack(Region *region, const PRegion *packed);
+
+/** True if packed position p lies within packed region r (inclusive)
+ */
+static inline int
+pregionContains(const PRegion *r, PVec2 p)
+{
+  return (pvec2Ge(p, r->topLeft) & pvec2Ge(r->botRight, p)) == 0xffff;
+}
+
 /** Computes the bounding box containing two regions.
  */
 void regionUnion(Region *rUnion, const Region *r1, const Region *r2);
 
-/** Clip region within screen bounds
+/** Clip region within screen bounds (0,0 to screenWidth-1,screenHeight-1).
+ *
+ *  Shapes' getBounds functions never clip, so that bounds are the same
+ *  wherever a shape is; renderers clip before drawing.  A region wholly
+ *  off the screen clips to an empty one (see regionIsEmpty).
  */
 void regionClipScreen(Region *region);
 
+/** True if region contains no pixels (a corner passed the other)
+ */
+int regionIsEmpty(const Region *region);
+
+#define REGION_SWEEP_STEP 0x100	/* time of a whole step, Q8 */
+#define REGION_SWEEP_MISS 0xffff
+#define REGION_SWEEP_OVERLAP 0xfffe	/* overlapping already (see regionPushOut) */
+
+/** Swept bounding boxes: if mover, moving by velocity over one step,
+ *  would come to share a pixel with (stationary) obstacle, when does it
+ *  first touch it (lie right next to it)?
+ *
+ *  \param axis (out) the axis on which they meet (whose faces touch)
+ *  \return the time of contact, 0 to REGION_SWEEP_STEP,
+ *  REGION_SWEEP_OVERLAP if they already overlap at the start, or
+ *  REGION_SWEEP_MISS if they don't meet during the step.  For a moving
+ *  obstacle, pass the velocity of mover relative to it.
+ */
+u_int regionSweep(const Region *mover, const Vec2 *velocity, const Region *obstacle, u_char *axis);
+
+/** The shortest way out of an overlap: mover, moved by push along the
+ *  returned axis, lies right next to obstacle (on whichever side is
+ *  nearer) instead of overlapping it.
+ *  \return the axis to push mover along
+ */
+u_char regionPushOut(const Region *mover, const Region *obstacle, int *push);
+
 /** This function initializes the screen
  *  vectors that are used by shapes
  *
@@ -79,10 +270,21 @@ void shapeInit();
  * 
  *  check: A function that determines if the AbShape contains pixelLoc when 
  *  rendered at centerPos
+ *
+ *  The third field is a pointer to
+ *
+ *  coverage: A function that computes which of the 16 pixels col..col+15
+ *  on row the AbShape contains when rendered at centerPos (see
+ *  abShapeCoverage).  May be 0, in which case check is used instead.
+ *
+ *  An AbShape's geometry and function pointers never change, so declare
+ *  instances const: they then stay in flash instead of being copied into
+ *  RAM (.data) at startup.  Shapes with state that changes must not be const.
  */
 typedef struct AbShape_s {		/* base type for all abstrct shapes */
   void (*getBounds)(const struct AbShape_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbShape_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  u_int (*coverage)(const struct AbShape_s *shape, const Vec2 *centerPos, int col, int row);
 } AbShape;
 
 /** Computes bounding box of abShape in screen coordinates 
@@ -102,6 +304,26 @@ void abShapeGetBounds(const AbShape *s, const Vec2 *centerPos, Region *bounds);
  */
 int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
 
+/** Coverage word: which of 16 consecutive pixels on a row a shape contains
+ *
+ *  Bit i is set if pixel (col + i, row) is within the abShape centered at
+ *  centerPos, so the least significant bit is the leftmost pixel.
+ *  Uses the shape's coverage function, or 16 calls to its check if it
+ *  has none.
+ *
+ *  \param shape (in) The abstract shape
+ *  \param centerPos (in) The Vec2 specifying the center position of the shape
+ *  \param col (in) Column of the pixel in bit 0
+ *  \param row (in) Row of the pixels
+ *  \return The coverage word
+ */
+u_int abShapeCoverage(const AbShape *shape, const Vec2 *centerPos, int col, int row);
+
+/** Coverage word of a horizontal span: bit i is set if left <= col + i <= right.
+ *  Shapes made of one or two spans per row compute their coverage with this.
+ */
+u_int coverageSpan(int col, int left, int right);
+
 /** An AbShape Right Arrow with filled tip
  *
  *  size: width of the arrow.  Tip is a triangle with width=1/2 size.
@@ -110,6 +332,7 @@ int abShapeCheck(const AbShape *shape, const Vec2 *centerPos, const Vec2 *pixelL
 typedef struct AbRArrow_s {
   void (*getBounds)(const struct AbRArrow_s *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRArrow_s *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  u_int (*coverage)(const struct AbRArrow_s *shape, const Vec2 *centerPos, int col, int row);
   int size;
 } AbRArrow;
 
@@ -121,6 +344,10 @@ void abRArrowGetBounds(const AbRArrow *arrow, const Vec2 *centerPos, Region *bou
  */
 int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+u_int abRArrowCoverage(const AbRArrow *arrow, const Vec2 *centerPos, int col, int row);
+
 /** AbShape rectangle
  *
  *  Vector halfSize must be to first quadrant (both axes non-negative).  
@@ -129,6 +356,7 @@ int abRArrowCheck(const AbRArrow *arrow, const Vec2 *centerPos, const Vec2 *pixe
 typedef struct AbRect_s {
   void (*getBounds)(const struct AbRect_s *rect, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbRect_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbRect_s *shape, const Vec2 *centerPos, int col, int row);
   const Vec2 halfSize;	
 } AbRect;
 
@@ -140,6 +368,10 @@ void abRectGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *bounds);
  */
 int abRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+u_int abRectCoverage(const AbRect *rect, const Vec2 *centerPos, int col, int row);
+
 typedef AbRect AbRectOutline;	/* same as AbRect */
 
 /** As required by AbShape
@@ -150,10 +382,15 @@ void abRectOutlineGetBounds(const AbRect *rect, const Vec2 *centerPos, Region *b
  */
 int abRectOutlineCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+u_int abRectOutlineCoverage(const AbRect *rect, const Vec2 *centerPos, int col, int row);
+
 /* Triangle shape */
 typedef struct AbTriangle {
   void (*getBounds)(const struct AbTriangle *shape, const Vec2 *centerPos, Region *bounds);
   int (*check)(const struct AbTriangle *shape, const Vec2 *centerPos, const Vec2 *pixelLoc);
+  u_int (*coverage)(const struct AbTriangle *shape, const Vec2 *centerPos, int col, int row);
   int size;
 } AbTriangle;
 
@@ -165,18 +402,187 @@ void abTriangleGetBounds(const AbTriangle *shape, const Vec2 *centerPos, Region
  */
 int abTriangleCheck(const AbTriangle *shape, const Vec2 *centerPos, const Vec2 *pixel);
 
+/** As required by AbShape
+ */
+u_int abTriangleCoverage(const AbTriangle *shape, const Vec2 *centerPos, int col, int row);
+
+/** AbShape defined by a table of horizontal spans per row
+ *
+ *  Generated offline (see spanLib's makeShapes) so that checking or
+ *  covering a pixel is just table lookups.  Offsets are relative to
+ *  the shape's center.
+ *
+ *  rows: for each of the height rows starting at row offset top, the
+ *  index in spans of the row's first span; rows[height] ends the last row.
+ *  spans: (left, right) col offset pairs, inclusive.
+ *  left, right: the shape's col extent, so bounds need no scan.
+ */
+typedef struct AbSpanShape_s {
+  void (*getBounds)(const struct AbSpanShape_s *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbSpanShape_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbSpanShape_s *shape, const Vec2 *centerPos, int col, int row);
+  const u_char *rows;
+  const signed char (*spans)[2];
+  signed char top;
+  u_char height;
+  signed char left, right;
+} AbSpanShape;
+
+/** As required by AbShape
+ */
+void abSpanGetBounds(const AbSpanShape *shape, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abSpanCheck(const AbSpanShape *shape, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+u_int abSpanCoverage(const AbSpanShape *shape, const Vec2 *centerPos, int col, int row);
+
+/** AbShape wrapping another shape scaled by a fixed-point factor
+ *
+ *  shape: the source shape, scaled about its center.
+ *  scale: Q8.8, so ABSCALED_ONE (0x100) is the source's size and 0x180
+ *  is half again as big.  Set it with abScaledSetScale.
+ *
+ *  The first time a (shape, scale) pair is used, the scaled shape is
+ *  sampled into an AbSpanShape kept in a small static arena of
+ *  ABSCALED_ARENA_SIZE bytes.  Later uses, by this or any other
+ *  AbScaled, find it there, so switching between sizes is free.
+ *  Entries are never freed.
+ */
+typedef struct AbScaled_s {
+  void (*getBounds)(const struct AbScaled_s *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbScaled_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbScaled_s *shape, const Vec2 *centerPos, int col, int row);
+  const AbShape *shape;
+  const AbSpanShape *scaled;	/* set by abScaledSetScale */
+  u_int scale;
+} AbScaled;
+
+#define ABSCALED_ONE 0x100
+#define ABSCALED_ARENA_SIZE 160
+
+/** Scale shape->shape by scale (Q8.8), building its span table if needed.
+ *  Call before first use.
+ *  \return 1, or 0 if the arena is full, scale is 0 (or 1), or the scaled
+ *  shape reaches more than 127 pixels from its center (in each case the
+ *  shape keeps its old scale)
+ */
+int abScaledSetScale(AbScaled *shape, u_int scale);
+
+/** As required by AbShape
+ */
+void abScaledGetBounds(const AbScaled *shape, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abScaledCheck(const AbScaled *shape, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+u_int abScaledCoverage(const AbScaled *shape, const Vec2 *centerPos, int col, int row);
+
+/** AbShape sprite pre-rotated to a number of orientations
+ *
+ *  Generated offline (see spanLib's makeShapes "rotate") as a set of
+ *  AbSpanShape frames.  Only orientations up to half a turn are stored,
+ *  since the rest are their point reflections; if the source shape is
+ *  left-right symmetric (mirrored), only those up to a quarter turn are,
+ *  since orientation steps/2 - k is then frame k flipped top to bottom.
+ *
+ *  orientation: current orientation, 0..steps-1, clockwise from the
+ *  source shape.  It may be changed at any time; rendering just picks
+ *  the frame and flips it, so there is no cost.
+ */
+typedef struct AbRotSprite_s {
+  void (*getBounds)(const struct AbRotSprite_s *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbRotSprite_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbRotSprite_s *shape, const Vec2 *centerPos, int col, int row);
+  const AbSpanShape *const *frames;
+  u_char steps;
+  u_char mirrored;
+  u_char orientation;
+} AbRotSprite;
+
+/** As required by AbShape
+ */
+void abRotSpriteGetBounds(const AbRotSprite *sprite, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abRotSpriteCheck(const AbRotSprite *sprite, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+u_int abRotSpriteCoverage(const AbRotSprite *sprite, const Vec2 *centerPos, int col, int row);
+
+/** AbShape convex polygon
+ *
+ *  vertices: count (col, row) offsets from the center, in order around
+ *  the polygon (either direction).  The polygon must be convex.
+ *  spans: room for maxRows (left, right) col offset pairs, one per row
+ *  the polygon covers; abPolygonInit fills them in.
+ *
+ *  abPolygonInit rasterizes the edges once by integer DDA (Bresenham)
+ *  stepping, which needs no multiplication or division, and caches
+ *  the bounds, so checks and coverage are then lookups.  An AbPolygon
+ *  is therefore modified at run time and may not be const.
+ */
+typedef struct AbPolygon_s {
+  void (*getBounds)(const struct AbPolygon_s *shape, const Vec2 *centerPos, Region *bounds);
+  int (*check)(const struct AbPolygon_s *shape, const Vec2 *centerPos, const Vec2 *pixel);
+  u_int (*coverage)(const struct AbPolygon_s *shape, const Vec2 *centerPos, int col, int row);
+  const signed char (*vertices)[2];
+  u_char count;
+  signed char (*spans)[2];
+  u_char maxRows;		/* rows spans has room for */
+  signed char top, left, right;	/* set by abPolygonInit */
+  u_char height;
+} AbPolygon;
+
+/** Rasterize polygon's edges into its spans and cache its bounds.
+ *  Call before first use and whenever vertices change.
+ *  \return 1, or 0 if the polygon covers more than maxRows rows (it is
+ *  then left empty, and never drawn)
+ */
+int abPolygonInit(AbPolygon *polygon);
+
+/** As required by AbShape
+ */
+void abPolygonGetBounds(const AbPolygon *polygon, const Vec2 *centerPos, Region *bounds);
+
+/** As required by AbShape
+ */
+int abPolygonCheck(const AbPolygon *polygon, const Vec2 *centerPos, const Vec2 *pixel);
+
+/** As required by AbShape
+ */
+u_int abPolygonCoverage(const AbPolygon *polygon, const Vec2 *centerPos, int col, int row);
+
+/** Static attributes of a layer.
+ *
+ *  These never change while the program runs, so declare them const
+ *  and they stay in flash rather than being copied into RAM.
+ */
+typedef struct LayerDesc_s {
+  const AbShape *abShape;
+  u_int color;
+} LayerDesc;
+
 /** Linked list of Layers.  
  * 
  *  Each layer contains
- *   - a referenced to an abstract shape to be rendered.
- *   - the layer's current position
- *   - the layer's color
+ *   - a reference to its (flash resident) shape and color
+ *   - the layer's current, last and next packed positions
  *   - a reference to the next (lower) layer.
+ *
+ *  Only the positions and link change, so a Layer needs just 10 bytes of RAM.
  */
 typedef struct Layer_s {
-  AbShape *abShape;
-  Vec2 pos, posLast, posNext; /* initially just set pos */
-  u_int color;
+  const LayerDesc *desc;
+  PVec2 pos, posLast, posNext; /* initially just set pos */
   struct Layer_s *next;
 } Layer;	
 
@@ -194,6 +600,51 @@ void layerInit(Layer *layers);
  */
 void layerDraw(Layer *layers);
 
+/** Render area (which must be within the screen) from count layers,
+ *  probes[0] in front.  Pixels not contained by a layer are set to bgColor.
+ *
+ *  Resolves 16 pixels at a time: each layer's coverage word, less the
+ *  pixels already claimed by layers in front of it, is the pixels it
+ *  colors.  Runs of pixels of one color are then written straight from
+ *  those masks.
+ */
+void layerComposite(const Layer *const *probes, u_char count, const Region *area);
+
+/** Render all layers by the painter's algorithm, for drawing a scene
+ *  the first time.
+ *
+ *  Clears the screen to bgColor, then paints each layer's covered
+ *  pixels within its bounds, back to front.  Background pixels are
+ *  written once by clearScreen rather than after probing every layer,
+ *  so this is much faster than layerDraw when layers cover little of
+ *  the screen.  The result is the same.
+ */
+void layerPaint(Layer *layers);
+
+/** As layerPaint, for count layers, probes[0] in front */
+void layerPaintLayers(const Layer *const *probes, u_char count);
+
+/** Most layers layerDraw or layerPaint can draw; any further down the list are not drawn */
+#define LAYER_PROBE_MAX 16
+
+/** RAM a layer used when it held its shape, color and three unpacked Vec2s */
+#define LAYER_RAM_UNPACKED \
+  (sizeof(AbShape *) + 3 * sizeof(Vec2) + sizeof(u_int) + sizeof(Layer *))
+
+/** Estimate the RAM a scene saves compared to keeping everything in RAM.
+ *
+ *  An estimate, not a measurement: counts the packed layers in the list
+ *  against the old layout (LAYER_RAM_UNPACKED) and adds the size of the
+ *  scene's const shapes, which the caller supplies since only it knows
+ *  their types, e.g. sizeof(rect10) + sizeof(fieldOutline).  For the
+ *  real figure, compare .data and .bss in the linker's map file.
+ *
+ *  \param layers (in) The scene's layer list
+ *  \param constShapeBytes (in) Total size of the scene's const AbShapes
+ *  \return Estimated bytes of RAM saved
+ */
+u_int layerRamSavedEstimate(const Layer *layers, u_int constShapeBytes);
+
 /** Background color.
   */
 extern u_int bgColor;		/*  background color */
@@ -3,10 +3,10 @@
 #include "lcddraw.h"
 #include "shape.h"
 
-const AbRect rect10 = {abRectGetBounds, abRectCheck, 10,10};;
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectCoverage, 10,10};;
 
 void
-abDrawPos(AbShape *shape, Vec2 *shapeCenter, u_int fg_color, u_int bg_color)
+abDrawPos(const AbShape *shape, const Vec2 *shapeCenter, u_int fg_color, u_int bg_color)
 {
   u_char row, col;
   Region bounds;
@@ -37,7 +37,7 @@ main()
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
   shapeInit();
   
-  abDrawPos((AbShape*)&rect10, &rectPos, COLOR_ORANGE, COLOR_BLUE);
+  abDrawPos((const AbShape*)&rect10, &rectPos, COLOR_ORANGE, COLOR_BLUE);
 
 }
 
@@ -3,32 +3,59 @@
 #include "lcddraw.h"
 #include "shape.h"
 
-AbRect rect10 = {abRectGetBounds, abRectCheck, 10,10};
-AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, 30};
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectCoverage, 10,10};
+const AbRArrow arrow30 = {abRArrowGetBounds, abRArrowCheck, abRArrowCoverage, 30};
 
+const signed char pentagonVertices[][2] = {{0,-12}, {11,-4}, {7,10}, {-7,10}, {-11,-4}};
+signed char pentagonSpans[23][2];	/* one per row: -12..10 */
+AbPolygon pentagon = {		/* spans & bounds set by abPolygonInit */
+  abPolygonGetBounds, abPolygonCheck, abPolygonCoverage,
+  pentagonVertices, 5, pentagonSpans, sizeof(pentagonSpans) / sizeof(pentagonSpans[0])
+};
 
-Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
+AbScaled halfRect10 = {		/* span table set by abScaledSetScale */
+  abScaledGetBounds, abScaledCheck, abScaledCoverage,
+  (const AbShape *)&rect10
+};
 
 
-Layer layer2 = {
-  (AbShape *)&arrow30,
-  {screenWidth/2+40, screenHeight/2+10}, 	    /* position */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_BLACK,
+const Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
+
+
+const LayerDesc blackArrow = {(const AbShape *)&arrow30, COLOR_BLACK};
+const LayerDesc redRect = {(const AbShape *)&rect10, COLOR_RED};
+const LayerDesc orangeRect = {(const AbShape *)&rect10, COLOR_ORANGE};
+const LayerDesc yellowPentagon = {(const AbShape *)&pentagon, COLOR_YELLOW};
+const LayerDesc greenHalfRect = {(const AbShape *)&halfRect10, COLOR_GREEN};
+
+Layer layer4 = {
+  &greenHalfRect,
+  pvec2(screenWidth - 30, screenHeight - 30), /* position */
+  0, 0,					    /* last & next pos */
   0,
 };
+Layer layer3 = {
+  &yellowPentagon,
+  pvec2(30, screenHeight - 30),	    /* position */
+  0, 0,					    /* last & next pos */
+  &layer4,
+};
+Layer layer2 = {
+  &blackArrow,
+  pvec2(screenWidth/2+40, screenHeight/2+10), 	    /* position */
+  0, 0,					    /* last & next pos */
+  &layer3,
+};
 Layer layer1 = {
-  (AbShape *)&rect10,
-  {screenWidth/2, screenHeight/2}, 	    /* position */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_RED,
+  &redRect,
+  pvec2(screenWidth/2, screenHeight/2), 	    /* position */
+  0, 0,					    /* last & next pos */
   &layer2,
 };
 Layer layer0 = {
-  (AbShape *)&rect10,
-  {(screenWidth/2)+10, (screenHeight/2)+5}, /* position */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_ORANGE,
+  &orangeRect,
+  pvec2((screenWidth/2)+10, (screenHeight/2)+5), /* position */
+  0, 0,					    /* last & next pos */
   &layer1,
 };
 
@@ -47,6 +74,8 @@ main()
   drawString5x7(20,20, "hello", COLOR_GREEN, COLOR_RED);
   shapeInit();
   
+  abPolygonInit(&pentagon);
+  abScaledSetScale(&halfRect10, ABSCALED_ONE / 2);
   layerInit(&layer0);
   layerDraw(&layer0);
   
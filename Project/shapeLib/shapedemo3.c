@@ -17,25 +17,26 @@ abSlicedRectCheck(const AbRect *rect, const Vec2 *centerPos, const Vec2 *pixel)
     return abRectCheck(rect, centerPos, pixel);
 }
 
-AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, 10,10};;
+const AbRect rect10 = {abRectGetBounds, abSlicedRectCheck, 0, 10,10};; /* no coverage: use check */
 
 
-Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
+const Region fence = {{10,30}, {SHORT_EDGE_PIXELS-10, LONG_EDGE_PIXELS-10}};
 
 
 #define numLayers 2
+const LayerDesc redRect = {(const AbShape *)&rect10, COLOR_RED};
+const LayerDesc orangeRect = {(const AbShape *)&rect10, COLOR_ORANGE};
+
 Layer layer1 = {
-  (AbShape *)&rect10,
-  {screenWidth/2, screenHeight/2}, /* position */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_RED,
+  &redRect,
+  pvec2(screenWidth/2, screenHeight/2), /* position */
+  0, 0,					    /* last & next pos */
   0,
 };
 Layer layer0 = {
-  (AbShape *)&rect10,
-  {(screenWidth/2)+15, (screenHeight/2)+10}, /* position */
-  {0,0}, {0,0},				    /* last & next pos */
-  COLOR_ORANGE,
+  &orangeRect,
+  pvec2((screenWidth/2)+15, (screenHeight/2)+10), /* position */
+  0, 0,					    /* last & next pos */
   &layer1,
 };
 
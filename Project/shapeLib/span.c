@@ -0,0 +1,40 @@
+#include "shape.h"
+
+void
+abSpanGetBounds(const AbSpanShape *shape, const Vec2 *centerPos, Region *bounds)
+{
+  bounds->topLeft.axes[0] = centerPos->axes[0] + shape->left;
+  bounds->topLeft.axes[1] = centerPos->axes[1] + shape->top;
+  bounds->botRight.axes[0] = centerPos->axes[0] + shape->right;
+  bounds->botRight.axes[1] = centerPos->axes[1] + shape->top + shape->height - 1;
+}
+
+// true if pixel is within one of its row's spans
+int
+abSpanCheck(const AbSpanShape *shape, const Vec2 *centerPos, const Vec2 *pixel)
+{
+  int col = pixel->axes[0] - centerPos->axes[0];
+  u_int row = pixel->axes[1] - centerPos->axes[1] - shape->top; /* negative wraps high */
+  u_char span, end;
+  if (row >= shape->height)
+    return 0;
+  for (span = shape->rows[row], end = shape->rows[row + 1]; span < end; span++)
+    if (col >= shape->spans[span][0] && col <= shape->spans[span][1])
+      return 1;
+  return 0;
+}
+
+// union of row's spans, clipped to pixels col..col+15
+u_int
+abSpanCoverage(const AbSpanShape *shape, const Vec2 *centerPos, int col, int row)
+{
+  u_int coverage = 0;
+  u_char span, end;
+  int center = centerPos->axes[0];
+  row -= centerPos->axes[1] + shape->top;
+  if ((u_int)row >= shape->height)
+    return 0;
+  for (span = shape->rows[row], end = shape->rows[row + 1]; span < end; span++)
+    coverage |= coverageSpan(col, center + shape->spans[span][0], center + shape->spans[span][1]);
+  return coverage;
+}
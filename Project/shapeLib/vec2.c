@@ -48,3 +48,22 @@ vec2Abs(Vec2 *vec)
       vec->axes[axis] = -val;
   }
 }
+
+void
+pvec2Pack(PVec2 *packed, const Vec2 *vec)
+{
+  u_char axis;
+  u_char bytes[2];
+  for (axis = 0; axis < 2; axis ++) {
+    int val = vec->axes[axis] + PVEC2_GUARD;
+    bytes[axis] = val < 0 ? 0 : (val > 0xff ? 0xff : val); /* clip guard */
+  }
+  *packed = (bytes[1] << 8) | bytes[0];
+}
+
+void
+pvec2Unpack(Vec2 *vec, PVec2 packed)
+{
+  vec->axes[0] = pvec2Col(packed);
+  vec->axes[1] = pvec2Row(packed);
+}
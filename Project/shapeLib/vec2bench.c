@@ -0,0 +1,85 @@
+/** \file vec2bench.c
+ *  \brief Compares the Vec2 functions with the packed (SWAR) PVec2 operations.
+ *
+ *  Each operation is run BENCH_ITERATIONS times and the average cost,
+ *  in MCLK cycles per call (loop overhead removed), is displayed as
+ *  "name  vec2  pvec2".
+ */
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "shape.h"
+
+#define BENCH_ITERATIONS 1000
+
+u_int bgColor = COLOR_BLACK;
+
+volatile PVec2 pa = pvec2(10, 150), pb = pvec2(-5, 20); /* volatile: defeat constant folding */
+volatile PVec2 pSink;
+Vec2 va = {10, 150}, vb = {-5, 20}, vSink;
+
+static unsigned long loopTicks;	/* cost of an empty loop */
+
+/** Cycles per iteration, less loop overhead */
+static u_int
+cyclesPerCall(unsigned long ticks)
+{
+  return ((ticks - loopTicks) * STOPWATCH_CYCLES_PER_TICK) / BENCH_ITERATIONS;
+}
+
+static void
+report(u_char row, char *name, unsigned long vecTicks, unsigned long packedTicks)
+{
+  char num[6];
+  drawString5x7(2, row, name, COLOR_WHITE, bgColor);
+  formatNum(num, cyclesPerCall(vecTicks), 5);
+  drawString5x7(50, row, num, COLOR_YELLOW, bgColor);
+  formatNum(num, cyclesPerCall(packedTicks), 5);
+  drawString5x7(90, row, num, COLOR_GREEN, bgColor);
+}
+
+/* Times the statement stmt, leaving the elapsed ticks in result */
+#define TIME(result, stmt) {				\
+    u_int i;						\
+    stopwatchStart();					\
+    for (i = 0; i < BENCH_ITERATIONS; i++) { stmt; }	\
+    result = stopwatchRead();				\
+  }
+
+int
+main()
+{
+  unsigned long vecTicks, packedTicks;
+  u_char row = 20;
+
+  configureClocks();
+  lcd_init();
+  or_sr(0x8);			/* GIE on: stopwatch needs its overflow interrupt */
+  clearScreen(bgColor);
+  drawString5x7(2, 5, "op     vec2  pvec2", COLOR_WHITE, bgColor);
+
+  TIME(loopTicks, asm volatile(""));
+
+  TIME(vecTicks, vec2Add(&vSink, &va, &vb));
+  TIME(packedTicks, pSink = pvec2Add(pa, pb));
+  report(row += 10, "add", vecTicks, packedTicks);
+
+  TIME(vecTicks, vec2Sub(&vSink, &va, &vb));
+  TIME(packedTicks, pSink = pvec2Sub(pa, pb));
+  report(row += 10, "sub", vecTicks, packedTicks);
+
+  TIME(vecTicks, vec2Min(&vSink, &va, &vb));
+  TIME(packedTicks, pSink = pvec2Min(pa, pb));
+  report(row += 10, "min", vecTicks, packedTicks);
+
+  TIME(vecTicks, vec2Max(&vSink, &va, &vb));
+  TIME(packedTicks, pSink = pvec2Max(pa, pb));
+  report(row += 10, "max", vecTicks, packedTicks);
+
+  TIME(vecTicks, vSink = vb; vec2Abs(&vSink));
+  TIME(packedTicks, pSink = pvec2Abs(pb));
+  report(row += 10, "abs", vecTicks, packedTicks);
+
+  or_sr(0x10);			/* CPU off */
+}
@@ -0,0 +1,81 @@
+#include "viewport.h"
+
+void
+viewportInit(Viewport *v, LayerTable *layers)
+{
+  v->layers = layers;
+  v->origin = vec2Zero;
+  v->placed = 0;
+}
+
+void
+viewportPlace(Viewport *v, u_char slot, int col, int row)
+{
+  v->world[slot].axes[0] = col;
+  v->world[slot].axes[1] = row;
+  v->placed |= layerTableBit(slot);
+}
+
+void
+viewportScrollTo(Viewport *v, int col, int row)
+{
+  v->origin.axes[0] = col;
+  v->origin.axes[1] = row;
+}
+
+u_int
+viewportProject(Viewport *v)
+{
+  LayerTable *t = v->layers;
+  u_int placed, bit, changed = 0;
+  u_char slot;
+  for (slot = 0, bit = 1, placed = v->placed; placed; slot++, bit <<= 1, placed >>= 1) {
+    Layer *l;
+    Vec2 screenPos;
+    Region bounds;
+    u_int wasVisible;
+    if (!(placed & 1))
+      continue;
+    l = t->layer[slot];
+    vec2Sub(&screenPos, &v->world[slot], &v->origin);
+    abShapeGetBounds(l->desc->abShape, &screenPos, &bounds);
+    wasVisible = t->visible & bit;
+    if (bounds.botRight.axes[0] < 0 || bounds.topLeft.axes[0] > screenWidth-1 ||
+	bounds.botRight.axes[1] < 0 || bounds.topLeft.axes[1] > screenHeight-1) {
+      t->visible &= ~bit;	/* culled */
+      if (!wasVisible)
+	continue;		/* still off screen: nothing to erase */
+    } else
+      t->visible |= bit;
+    pvec2Pack(&l->posNext, &screenPos);
+    if (l->posNext != l->pos || !wasVisible)
+      changed |= bit;
+  }
+  return changed;
+}
+
+void
+viewportCommit(Viewport *v, u_int changed)
+{
+  u_char slot;
+  for (slot = 0; changed; slot++, changed >>= 1) {
+    if (changed & 1) {
+      Layer *l = v->layers->layer[slot];
+      l->posLast = l->pos;
+      l->pos = l->posNext;
+    }
+  }
+}
+
+void
+viewportDraw(const Viewport *v, u_int changed)
+{
+  u_char slot;
+  for (slot = 0; changed; slot++, changed >>= 1) {
+    if (changed & 1) {
+      Region bounds;
+      layerGetBounds(v->layers->layer[slot], &bounds);
+      layerTableDrawRegion(v->layers, &bounds);
+    }
+  }
+}
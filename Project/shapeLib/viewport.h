@@ -0,0 +1,63 @@
+/** \file viewport.h
+ *  \brief A screen-sized window scrolling over a larger world of layers.
+ *
+ *  Layers' packed positions are screen coordinates, which fit in a
+ *  byte.  A Viewport keeps the world position (an int per axis) of
+ *  each layer it places in a LayerTable, and the world position of the
+ *  screen's top-left pixel (origin).  viewportProject converts world
+ *  positions to screen positions and culls: a layer whose bounds lie
+ *  wholly off the screen is hidden, so the renderers never probe it.
+ *  The cost of a frame therefore depends on what is on the screen, not
+ *  on the size of the world.
+ *
+ *  The viewport owns the visibility of the layers it places; use
+ *  layerTableShow/Hide only for layers it does not place.  A layer
+ *  partly on the screen is drawn correctly provided its center is
+ *  within the clip guard (PVEC2_GUARD) of the screen, i.e. shapes
+ *  extend no more than PVEC2_GUARD pixels from their centers.
+ */
+#ifndef viewport_included
+#define viewport_included
+
+#include "layerTable.h"
+
+typedef struct {
+  LayerTable *layers;
+  Vec2 origin;			/* world position of screen pixel (0,0) */
+  Vec2 world[LAYER_TABLE_SIZE];	/* by slot: layer center, world coordinates */
+  u_int placed;			/* by slot: layers positioned by the viewport */
+} Viewport;
+
+/** Watch layers, with the screen's top left at world position (0,0) */
+void viewportInit(Viewport *v, LayerTable *layers);
+
+/** Position the layer in slot at world position (col, row)
+ *  from the next viewportProject on.
+ */
+void viewportPlace(Viewport *v, u_char slot, int col, int row);
+
+/** Stop positioning the layer in slot (e.g. before removing it) */
+#define viewportRelease(v, slot) ((v)->placed &= ~layerTableBit(slot))
+
+/** Scroll so that world position (col, row) is at the screen's top left */
+void viewportScrollTo(Viewport *v, int col, int row);
+
+/** Compute the next screen position (posNext) of every placed layer
+ *  and hide those wholly off the screen.
+ *
+ *  \return the slots whose screen position or visibility changed,
+ *  one bit each, for viewportCommit and viewportDraw.
+ */
+u_int viewportProject(Viewport *v);
+
+/** Make the next positions of the changed slots current, remembering
+ *  the old ones so viewportDraw can erase them.
+ */
+void viewportCommit(Viewport *v, u_int changed);
+
+/** Redraw the last and current bounds of the changed slots.
+ *  Culled layers' bounds clip to nothing, so cost nothing to draw.
+ */
+void viewportDraw(const Viewport *v, u_int changed);
+
+#endif // viewport_included
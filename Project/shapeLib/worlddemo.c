@@ -0,0 +1,77 @@
+#include <msp430.h>
+#include <libTimer.h>
+#include "lcdutils.h"
+#include "lcddraw.h"
+#include "viewport.h"
+
+#define WORLD_WIDTH 512		/* four screens wide */
+#define WORLD_HEIGHT 480	/* three screens high */
+
+u_int bgColor = COLOR_BLUE;
+
+const AbRect rect10 = {abRectGetBounds, abRectCheck, abRectCoverage, 10,10};
+const AbRect rect4x20 = {abRectGetBounds, abRectCheck, abRectCoverage, 4,20};
+const AbRectOutline box12 = {abRectOutlineGetBounds, abRectOutlineCheck, abRectOutlineCoverage, 12,12};
+const AbRArrow arrow20 = {abRArrowGetBounds, abRArrowCheck, abRArrowCoverage, 20};
+
+const LayerDesc redRect = {(const AbShape *)&rect10, COLOR_RED};
+const LayerDesc orangePost = {(const AbShape *)&rect4x20, COLOR_ORANGE};
+const LayerDesc whiteBox = {(const AbShape *)&box12, COLOR_WHITE};
+const LayerDesc blackArrow = {(const AbShape *)&arrow20, COLOR_BLACK};
+
+/** Landmarks scattered over the world: descriptor and world position */
+typedef struct {
+  const LayerDesc *desc;
+  int col, row;
+} Landmark;
+
+static const Landmark landmarks[] = {
+  {&whiteBox, 20, 20},       {&redRect, 200, 60},     {&orangePost, 400, 30},
+  {&blackArrow, 90, 200},    {&whiteBox, 300, 240},   {&redRect, 480, 200},
+  {&orangePost, 150, 400},   {&blackArrow, 350, 430}, {&whiteBox, 500, 460},
+  {&redRect, 60, 300},       {&orangePost, 250, 150}, {&blackArrow, 440, 330},
+};
+#define LANDMARK_COUNT (sizeof(landmarks) / sizeof(landmarks[0]))
+
+Layer layers[LANDMARK_COUNT];
+LayerTable table;
+Viewport view;
+
+int
+main()
+{
+  u_char i;
+  int col = 0, row = 0, dCol = 2, dRow = 1;
+  configureClocks();
+  lcd_init();
+
+  layerTableInit(&table);
+  viewportInit(&view, &table);
+  for (i = 0; i < LANDMARK_COUNT; i++) {
+    u_char slot;
+    layers[i].desc = landmarks[i].desc;
+    slot = layerTableInsert(&table, &layers[i]);
+    viewportPlace(&view, slot, landmarks[i].col, landmarks[i].row);
+  }
+  viewportCommit(&view, viewportProject(&view));
+  layerTablePaint(&table);
+
+  for (;;) {			/* pan back and forth across the world */
+    u_int changed;
+    col += dCol;
+    row += dRow;
+    if (col < 0 || col > WORLD_WIDTH - screenWidth) {
+      dCol = -dCol;
+      col += 2 * dCol;
+    }
+    if (row < 0 || row > WORLD_HEIGHT - screenHeight) {
+      dRow = -dRow;
+      row += 2 * dRow;
+    }
+    viewportScrollTo(&view, col, row);
+    changed = viewportProject(&view);
+    viewportCommit(&view, changed);
+    viewportDraw(&view, changed);
+    __delay_cycles(400000);	/* 1/40 s */
+  }
+}
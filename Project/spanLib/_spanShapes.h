@@ -0,0 +1,10 @@
+#ifndef spanShapes_included
+#define spanShapes_included
+
+#include "shape.h"
+
+/** Span-table AbShapes compiled from shapes.def by makeShapes.
+ *  Each is an AbSpanShape (see shape.h) named as in shapes.def.
+ */
+
+#endif
@@ -0,0 +1,307 @@
+///////////////////////////////////////////
+// makeShapes: compile shape descriptions into span tables
+//
+// Reads shapes.def (see its header for the format), rasterizes each
+// shape on the host, and emits for each one shapes/NAME.c holding its
+// per-row span table and a const AbSpanShape instance, so that at run
+// time checking a pixel is just table lookups.
+// Shapes prefixed with "rotate STEPS" instead become an AbRotSprite:
+// span tables for the shape pre-rotated to each of STEPS orientations,
+// less those the runtime derives by flipping stored ones.
+// Declarations go to spanShapes_decls.h.
+///////////////////////////////////////////
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define RASTER_HALF 64		/* offsets from center: -64..63 */
+#define RASTER_SIZE (2 * RASTER_HALF)
+#define MAX_VERTICES 32
+#define MAX_BITMAP_ROWS RASTER_SIZE
+
+typedef enum { POLYGON, ELLIPSE, RRECT, BITMAP } Kind;
+
+typedef struct {
+  Kind kind;
+  char name[64];
+  int steps;				/* orientations if rotated, else 0 */
+  int nVertices;
+  double vertices[MAX_VERTICES][2];	/* polygon */
+  double halfWidth, halfHeight, radius;	/* ellipse & rrect */
+  int centerCol, centerRow, bitmapRows;	/* bitmap */
+  char bitmap[MAX_BITMAP_ROWS][RASTER_SIZE + 2];
+} ShapeDesc;
+
+typedef unsigned char Raster[RASTER_SIZE][RASTER_SIZE]; /* [row][col] */
+
+/* true if (col, row) is on segment a-b */
+static int
+onSegment(const double *a, const double *b, double col, double row)
+{
+  double cross = (b[0] - a[0]) * (row - a[1]) - (b[1] - a[1]) * (col - a[0]);
+  if (cross > 1e-9 || cross < -1e-9)
+    return 0;
+  return (col >= (a[0] < b[0] ? a[0] : b[0]) - 1e-9 && col <= (a[0] > b[0] ? a[0] : b[0]) + 1e-9 &&
+	  row >= (a[1] < b[1] ? a[1] : b[1]) - 1e-9 && row <= (a[1] > b[1] ? a[1] : b[1]) + 1e-9);
+}
+
+/* true if the shape contains the point (col, row), relative to its center */
+static int
+inside(const ShapeDesc *s, double col, double row)
+{
+  switch (s->kind) {
+  case POLYGON: {		/* edges are inside; otherwise count crossings */
+    int i, crossings = 0;
+    for (i = 0; i < s->nVertices; i++) {
+      const double *a = s->vertices[i], *b = s->vertices[(i + 1) % s->nVertices];
+      if (onSegment(a, b, col, row))
+	return 1;
+      if ((a[1] > row) != (b[1] > row) &&
+	  col < a[0] + (row - a[1]) * (b[0] - a[0]) / (b[1] - a[1]))
+	crossings++;
+    }
+    return crossings & 1;
+  }
+  case ELLIPSE: {		/* half a pixel of slack so the axes' ends are in */
+    double c = col / (s->halfWidth + 0.5), r = row / (s->halfHeight + 0.5);
+    return c * c + r * r <= 1.0;
+  }
+  case RRECT: {
+    double c = col < 0 ? -col : col, r = row < 0 ? -row : row;
+    double cornerCol = s->halfWidth - s->radius, cornerRow = s->halfHeight - s->radius;
+    if (c > s->halfWidth + 1e-9 || r > s->halfHeight + 1e-9)
+      return 0;
+    if (c <= cornerCol || r <= cornerRow)
+      return 1;
+    c -= cornerCol; r -= cornerRow;
+    return c * c + r * r <= (s->radius + 0.5) * (s->radius + 0.5);
+  }
+  case BITMAP: {		/* nearest bitmap pixel */
+    int bc = (int)(col + s->centerCol + RASTER_SIZE + 0.5) - RASTER_SIZE;
+    int br = (int)(row + s->centerRow + RASTER_SIZE + 0.5) - RASTER_SIZE;
+    if (br < 0 || br >= s->bitmapRows || bc < 0 || bc >= (int)strlen(s->bitmap[br]))
+      return 0;
+    return s->bitmap[br][bc] == '#';
+  }
+  }
+  return 0;
+}
+
+/* sample the shape, turned clockwise by angle radians, at every pixel */
+static void
+rasterize(const ShapeDesc *s, double angle, Raster raster)
+{
+  int row, col;
+  double c = cos(angle), sn = sin(angle);
+  for (row = 0; row < RASTER_SIZE; row++)
+    for (col = 0; col < RASTER_SIZE; col++) {
+      double x = col - RASTER_HALF, y = row - RASTER_HALF;
+      /* turn pixel back counterclockwise (rows grow down) */
+      raster[row][col] = inside(s, x * c + y * sn, y * c - x * sn);
+    }
+}
+
+/* true if raster is unchanged by mirroring left to right about col 0 */
+static int
+isMirrored(Raster raster)
+{
+  int row, col;
+  for (row = 0; row < RASTER_SIZE; row++)
+    for (col = 1; col < RASTER_SIZE; col++) /* col 0 (offset -64) has no mirror */
+      if (raster[row][col] != raster[row][RASTER_SIZE - col])
+	return 0;
+  return 1;
+}
+
+/* emit raster's span table and an AbSpanShape called name into fp.
+   storage is "" or "static " */
+static void
+emitSpans(FILE *fp, const char *storage, const char *name, Raster raster)
+{
+  int row, col, top = RASTER_SIZE, bottom = -1, left = RASTER_SIZE, right = -1;
+  int spanCount = 0;
+
+  for (row = 0; row < RASTER_SIZE; row++)
+    for (col = 0; col < RASTER_SIZE; col++)
+      if (raster[row][col]) {
+	if (row < top) top = row;
+	bottom = row;
+	if (col < left) left = col;
+	if (col > right) right = col;
+      }
+  if (bottom < 0) {
+    fprintf(stderr, "makeShapes: %s is empty\n", name);
+    exit(1);
+  }
+
+  fprintf(fp, "static const signed char %s_spans[][2] = {\n", name);
+  for (row = top; row <= bottom; row++) {
+    fprintf(fp, "  ");
+    for (col = 0; col < RASTER_SIZE; col++)
+      if (raster[row][col] && (col == 0 || !raster[row][col - 1])) { /* span starts */
+	int end = col;
+	while (end + 1 < RASTER_SIZE && raster[row][end + 1])
+	  end++;
+	fprintf(fp, "{%d,%d}, ", col - RASTER_HALF, end - RASTER_HALF);
+	spanCount++;
+      }
+    fprintf(fp, "// row %d\n", row - RASTER_HALF);
+  }
+  fprintf(fp, "};\n\n");
+  if (spanCount > 255) {	/* rows[] indexes spans with a u_char */
+    fprintf(stderr, "makeShapes: %s has too many spans (%d)\n", name, spanCount);
+    exit(1);
+  }
+
+  fprintf(fp, "static const unsigned char %s_rows[%d] = {\n  ", name, bottom - top + 2);
+  spanCount = 0;
+  for (row = top; row <= bottom; row++) {
+    fprintf(fp, "%d, ", spanCount);
+    for (col = 0; col < RASTER_SIZE; col++)
+      if (raster[row][col] && (col == 0 || !raster[row][col - 1]))
+	spanCount++;
+  }
+  fprintf(fp, "%d\n};\n\n", spanCount);
+
+  fprintf(fp, "%sconst AbSpanShape %s = {\n", storage, name);
+  fprintf(fp, "  abSpanGetBounds, abSpanCheck, abSpanCoverage,\n");
+  fprintf(fp, "  %s_rows, %s_spans, %d, %d, %d, %d\n};\n",
+	  name, name, top - RASTER_HALF, bottom - top + 1, left - RASTER_HALF, right - RASTER_HALF);
+}
+
+/* emit the pre-rotated frames of s and an AbRotSprite into fp.
+
+   Only orientations up to half a turn are stored: the rest are their
+   point reflections.  If s is left-right symmetric, only orientations
+   up to a quarter turn are stored: orientation steps/2 - k is then
+   frame k flipped top to bottom.  See abRotSpriteFrame. */
+static void
+emitRotSprite(FILE *fp, const ShapeDesc *s, Raster raster)
+{
+  char frameName[80];
+  int frame, frames, mirrored;
+  rasterize(s, 0, raster);
+  mirrored = isMirrored(raster);
+  frames = mirrored ? s->steps / 4 + 1 : s->steps / 2;
+  for (frame = 0; frame < frames; frame++) {
+    sprintf(frameName, "%s_rot%d", s->name, frame);
+    rasterize(s, 2 * M_PI * frame / s->steps, raster);
+    emitSpans(fp, "static ", frameName, raster);
+    fprintf(fp, "\n");
+  }
+  fprintf(fp, "static const AbSpanShape *const %s_frames[%d] = {\n", s->name, frames);
+  for (frame = 0; frame < frames; frame++)
+    fprintf(fp, "  &%s_rot%d,\n", s->name, frame);
+  fprintf(fp, "};\n\n");
+  fprintf(fp, "AbRotSprite %s = {\n", s->name);
+  fprintf(fp, "  abRotSpriteGetBounds, abRotSpriteCheck, abRotSpriteCoverage,\n");
+  fprintf(fp, "  %s_frames, %d, %d, 0\n};\n", s->name, s->steps, mirrored);
+}
+
+/* exit with "makeShapes: what name" unless ok */
+static void
+require(int ok, const char *what, const char *name)
+{
+  if (!ok) {
+    fprintf(stderr, "makeShapes: %s %s\n", what, name);
+    exit(1);
+  }
+}
+
+/* read the next shape from fp into s.  Returns 0 at end of file */
+static int
+readShape(FILE *fp, ShapeDesc *s)
+{
+  char line[512], kind[16];
+  while (fgets(line, sizeof(line), fp)) {
+    int n;
+    char *p = line;
+    s->steps = 0;
+    if (sscanf(line, " rotate %d%n", &s->steps, &n) == 1) {
+      if (s->steps < 4 || s->steps % 4 || s->steps > 64) {
+	fprintf(stderr, "makeShapes: rotate steps must be a multiple of 4 up to 64\n");
+	exit(1);
+      }
+      p += n;
+    }
+    if (p[0] == '#' || sscanf(p, "%15s %63s%n", kind, s->name, &n) < 2)
+      continue;			/* comment or blank */
+    p += n;
+    if (!strcmp(kind, "polygon")) {
+      int used;
+      s->kind = POLYGON;
+      for (s->nVertices = 0;
+	   s->nVertices < MAX_VERTICES &&
+	     sscanf(p, " %lf,%lf%n", &s->vertices[s->nVertices][0], &s->vertices[s->nVertices][1], &used) == 2;
+	   s->nVertices++)
+	p += used;
+      require(s->nVertices >= 3, "fewer than 3 vertices in polygon", s->name);
+    } else if (!strcmp(kind, "ellipse")) {
+      s->kind = ELLIPSE;
+      require(sscanf(p, "%lf %lf", &s->halfWidth, &s->halfHeight) == 2,
+	      "expected half width and height for ellipse", s->name);
+    } else if (!strcmp(kind, "rrect")) {
+      s->kind = RRECT;
+      require(sscanf(p, "%lf %lf %lf", &s->halfWidth, &s->halfHeight, &s->radius) == 3,
+	      "expected half width, height and radius for rrect", s->name);
+    } else if (!strcmp(kind, "bitmap")) {
+      s->kind = BITMAP;
+      require(sscanf(p, "%d %d", &s->centerCol, &s->centerRow) == 2,
+	      "expected center column and row for bitmap", s->name);
+      for (s->bitmapRows = 0;
+	   s->bitmapRows < MAX_BITMAP_ROWS &&
+	     fgets(s->bitmap[s->bitmapRows], sizeof(s->bitmap[0]), fp) &&
+	     strspn(s->bitmap[s->bitmapRows], "#.") > 0;
+	   s->bitmapRows++)
+	s->bitmap[s->bitmapRows][strspn(s->bitmap[s->bitmapRows], "#.")] = 0;
+    } else {
+      fprintf(stderr, "makeShapes: unknown shape kind %s\n", kind);
+      exit(1);
+    }
+    return 1;
+  }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  static ShapeDesc shape;
+  static Raster raster;
+  char filename[100];
+  const char *defsName = argc > 1 ? argv[1] : "shapes.def";
+  FILE *defs = fopen(defsName, "r");
+  FILE *declFile = fopen("spanShapes_decls.h", "w");
+  require(defs != 0, "can't read", defsName);
+  require(declFile != 0, "can't write", "spanShapes_decls.h");
+
+  fprintf(declFile, "// Automatically generated by makeShapes from shapes.def\n");
+  fprintf(declFile, "#ifndef spanShapes_decls_included\n#define spanShapes_decls_included\n\n");
+
+  while (readShape(defs, &shape)) {
+    FILE *fp;
+    sprintf(filename, "shapes/%s.c", shape.name);
+    fp = fopen(filename, "w");
+    require(fp != 0, "can't write", filename);
+    fprintf(fp, "// Automatically generated by makeShapes from shapes.def\n");
+    fprintf(fp, "#include \"shape.h\"\n\n");
+    if (shape.steps)
+      emitRotSprite(fp, &shape, raster);
+    else {
+      rasterize(&shape, 0, raster);
+      emitSpans(fp, "", shape.name, raster);
+    }
+    fclose(fp);
+    if (shape.steps)
+      fprintf(declFile, "extern AbRotSprite %s;\n", shape.name);
+    else
+      fprintf(declFile, "extern const AbSpanShape %s;\n", shape.name);
+  }
+
+  fprintf(declFile, "\n#endif // included \n");
+  fclose(declFile);
+  fclose(defs);
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <msp430.h>
+#include <libTimer.h>
+#include <lcdutils.h>
+#include <lcddraw.h>
+#include "spanShapes.h"
+
+u_int bgColor = COLOR_BLACK;
+
+const LayerDesc greenInvader = {(const AbShape *)&invader, COLOR_GREEN};
+const LayerDesc whiteHull = {(const AbShape *)&shipHull, COLOR_WHITE};
+const LayerDesc graySaucer = {(const AbShape *)&saucer12x5, COLOR_GRAY};
+const LayerDesc orangeHexagon = {(const AbShape *)&hexagon8, COLOR_ORANGE};
+const LayerDesc blueButton = {(const AbShape *)&button20x8, COLOR_BLUE};
+const LayerDesc yellowArrow = {(const AbShape *)&shipArrow, COLOR_YELLOW};
+const LayerDesc brownRock = {(const AbShape *)&rock, COLOR_BROWN};
+
+Layer rockLayer = {&brownRock, pvec2(screenWidth-30, 70), 0, 0, 0};
+Layer arrowLayer = {&yellowArrow, pvec2(screenWidth/2, 100), 0, 0, &rockLayer};
+Layer buttonLayer = {&blueButton, pvec2(screenWidth/2, screenHeight-20), 0, 0, &arrowLayer};
+Layer hexagonLayer = {&orangeHexagon, pvec2(30, 70), 0, 0, &buttonLayer};
+Layer saucerLayer = {&graySaucer, pvec2(screenWidth/2, 40), 0, 0, &hexagonLayer};
+Layer hullLayer = {&whiteHull, pvec2(screenWidth/2, screenHeight/2), 0, 0, &saucerLayer};
+Layer invaderLayer = {&greenInvader, pvec2(screenWidth/2, 20), 0, 0, &hullLayer};
+
+int
+main()
+{
+  configureClocks();
+  lcd_init();
+
+  layerPaint(&invaderLayer);
+  drawString5x7(20, 2, "span shapes", COLOR_WHITE, bgColor);
+
+  for (;;) {			/* spin the pre-rotated sprites */
+    const Layer *probes[LAYER_PROBE_MAX];
+    u_char count = 0;
+    Layer *l;
+    for (l = &invaderLayer; l; l = l->next)
+      probes[count++] = l;
+    for (l = &arrowLayer; l; l = l->next) {
+      AbRotSprite *sprite = (AbRotSprite *)l->desc->abShape;
+      Region before, after, area;
+      Vec2 center;
+      pvec2Unpack(&center, l->pos);
+      abShapeGetBounds((const AbShape *)sprite, &center, &before);
+      sprite->orientation = (sprite->orientation + 1) % sprite->steps;
+      abShapeGetBounds((const AbShape *)sprite, &center, &after);
+      regionUnion(&area, &before, &after);
+      regionClipScreen(&area);
+      layerComposite(probes, count, &area);
+    }
+    __delay_cycles(4000000);	/* 1/4 s */
+  }
+}
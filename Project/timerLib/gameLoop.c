@@ -0,0 +1,37 @@
+#include "gameLoop.h"
+
+volatile unsigned int gameLoopTicks;
+
+void
+gameLoopInit(GameLoop *loop, void (*step)(), void (*render)(),
+	     unsigned char ticksPerStep, unsigned char maxSteps)
+{
+  loop->step = step;
+  loop->render = render;
+  loop->ticksPerStep = ticksPerStep;
+  loop->maxSteps = maxSteps;
+  loop->seen = gameLoopTicks;
+  loop->ticks = loop->dropped = loop->frames = loop->skipped = 0;
+}
+
+unsigned char
+gameLoopUpdate(GameLoop *loop)
+{
+  unsigned int due = gameLoopTicks - loop->seen; /* one read: ticks may keep coming */
+  unsigned char steps = 0;
+  if (due < loop->ticksPerStep)
+    return 0;
+  for (; due >= loop->ticksPerStep; due -= loop->ticksPerStep) {
+    if (steps < loop->maxSteps) {
+      loop->step();
+      steps++;
+      loop->ticks += loop->ticksPerStep;
+    } else			/* too far behind: drop the ticks */
+      loop->dropped += loop->ticksPerStep;
+    loop->seen += loop->ticksPerStep;
+  }
+  loop->render();
+  loop->frames++;
+  loop->skipped += steps - 1;
+  return steps;
+}
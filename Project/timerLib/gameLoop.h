@@ -0,0 +1,51 @@
+#ifndef gameLoop_included
+#define gameLoop_included
+
+/** Fixed time step game loop
+ *
+ *  The watchdog ISR only counts ticks, with gameLoopTick.  The main
+ *  loop calls gameLoopUpdate, which runs the simulation one fixed step
+ *  for every ticksPerStep ticks that have passed and then renders once.
+ *  When rendering can't keep up, several steps run between renders:
+ *  frames are dropped, but the simulation keeps time.  Beyond maxSteps
+ *  steps per render the ticks are dropped too, and the game slows.
+ */
+typedef struct {
+  void (*step)();		/* advance the simulation one step */
+  void (*render)();		/* draw the simulation's current state */
+  unsigned char ticksPerStep;
+  unsigned char maxSteps;	/* most steps run before rendering */
+  unsigned int seen;		/* gameLoopTicks already taken */
+  unsigned long ticks;		/* ticks simulated: ticksPerStep a step run */
+  unsigned long dropped;	/* ticks dropped beyond maxSteps: time the game lost */
+  unsigned long frames;		/* frames rendered */
+  unsigned long skipped;	/* frames skipped: steps that were not rendered */
+} GameLoop;
+
+/** Ticks counted so far (wrapping).  Only the ISR writes it, and a
+ *  16-bit read is a single instruction, so it is never torn.
+ */
+extern volatile unsigned int gameLoopTicks;
+
+/** Count a tick.  Call from the watchdog ISR.
+ *  \return nonzero once a step is due (so the ISR can wake the CPU)
+ */
+static inline int
+gameLoopTick(const GameLoop *loop)
+{
+  return (unsigned int)(++gameLoopTicks - loop->seen) >= loop->ticksPerStep;
+}
+
+/** Set up loop to call step every ticksPerStep ticks and render after
+ *  the steps due, running at most maxSteps steps per render.
+ */
+void gameLoopInit(GameLoop *loop, void (*step)(), void (*render)(),
+		  unsigned char ticksPerStep, unsigned char maxSteps);
+
+/** Run every step due, then render once.
+ *  \return the number of steps run: 0 if none was due, so the caller
+ *  may sleep until the next tick
+ */
+unsigned char gameLoopUpdate(GameLoop *loop);
+
+#endif
@@ -3,5 +3,7 @@
 
 #include "clocksTimer.h"
 #include "sr.h"
+#include "stopwatch.h"
+#include "gameLoop.h"
 
 #endif // included
@@ -0,0 +1,33 @@
+#include <msp430.h>
+#include "stopwatch.h"
+
+static volatile unsigned int overflows;
+
+void
+stopwatchStart()
+{
+  overflows = 0;
+  // Timer A1: SMCLK, continuous mode, cleared, overflow interrupt on
+  TA1CTL = TASSEL_2 + MC_2 + TACLR + TAIE;
+}
+
+unsigned long
+stopwatchRead()
+{
+  unsigned int hi, lo;
+  do {
+    hi = overflows;
+    lo = TA1R;
+  } while (hi != overflows);
+  if ((TA1CTL & TAIFG) && lo < 0x8000)	/* overflow not yet serviced */
+    hi++;
+  return ((unsigned long)hi << 16) | lo;
+}
+
+void
+__attribute__((interrupt(TIMER1_A1_VECTOR)))
+stopwatchOverflow()
+{
+  TA1CTL &= ~TAIFG;
+  overflows++;
+}
@@ -0,0 +1,15 @@
+#ifndef stopwatch_included
+#define stopwatch_included
+
+/** Stopwatch for benchmarks, using Timer1_A
+ *
+ *  Timer1_A counts SMCLK (2 MHz once configureClocks() has run), and
+ *  an overflow interrupt extends it to 32 bits, so a reading spans
+ *  up to about 35 minutes.  Interrupts (GIE) must be enabled.
+ */
+#define STOPWATCH_CYCLES_PER_TICK 8	/* MCLK 16 MHz / SMCLK 2 MHz */
+
+void stopwatchStart();			/* reset to zero and run */
+unsigned long stopwatchRead();		/* SMCLK ticks since start */
+
+#endif